@@ -0,0 +1,48 @@
+#!/bin/sh
+#**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: afinidad.sh
+#	Descripcion: Compara el receptor POSIX con los hilos repartidos por el kernel y con cada rol
+#                fijado a sus CPUs (-C). Sin topología se arma una con las CPUs en línea: ingreso
+#                en la 0, escritura en la última y trabajo y consola en las del medio.
+#               Uso: ./afinidad.sh [clientes] [repeticiones] [topologia] [filecarga] [filedatos]
+#****************************************************************
+
+CLIENTES=${1:-4}
+REPETICIONES=${2:-20}
+CPUS=$(getconf _NPROCESSORS_ONLN)
+ULTIMA=$((CPUS - 1))
+if [ "$CPUS" -ge 3 ]; then
+    MEDIO="1-$((CPUS - 2))"
+else
+    MEDIO=0
+fi
+TOPOLOGIA=${3:-ingreso=0:trabajo=$MEDIO:escritura=$ULTIMA:consola=$MEDIO}
+CARGA=${4:-carga.txt}
+DATOS=${5:-basedatos.txt}
+DIR=$(cd "$(dirname "$0")" && pwd)
+cd "$DIR" || exit 1
+
+make -s carga && make -s -C ../POSIX receptor || exit 1
+
+echo "Clientes: $CLIENTES, repeticiones: $REPETICIONES, CPUs en línea: $CPUS, topología fijada: $TOPOLOGIA"
+printf "%-10s %8s %8s %10s %9s %9s %9s %9s %8s %8s %8s %8s\n" \
+    config ops seg ops/s p50_us p95_us p99_us max_us cpu_usr cpu_sis rss_kb perdidas
+for CONFIG in "libre:-w 2" "fijada:-w 2 -C $TOPOLOGIA"; do
+    ETIQUETA=${CONFIG%%:*}
+    OPCIONES=${CONFIG#*:}
+    rm -f pipe_*
+    ./carga -r ../POSIX/receptor -f "$DATOS" -w "$CARGA" -c "$CLIENTES" -n "$REPETICIONES" \
+        -s "salida_$ETIQUETA.txt" -x "$OPCIONES" -e "$ETIQUETA"
+done
+
+# Fijar los hilos no debe cambiar el resultado
+if cmp -s salida_libre.txt salida_fijada.txt; then
+    echo "  fijada: estado final igual al de libre"
+else
+    echo "  fijada: estado final DIFERENTE al de libre"
+fi
@@ -0,0 +1,448 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: carga.c
+#	Descripcion: Generador de carga para comparar los receptores (POSIX y los modelos del unificado).
+#                Lanza el receptor indicado, lo alimenta con la misma carga grabada desde varios
+#                clientes concurrentes y reporta throughput, latencias, tiempo de CPU y memoria (RSS).
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <time.h>
+#include <errno.h>
+#include <signal.h>
+#include <limits.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include "carga.h"
+
+// Devuelve el tiempo monotónico actual en nanosegundos
+static long long ahoraNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Lee la carga grabada con el mismo formato de operaciones.txt (Operación, Libro, ISBN)
+int leerCarga(char *nomArchivo, struct OpCarga *ops) {
+    FILE *archivo = fopen(nomArchivo, "r");
+    if (!archivo) {
+        printf("Error al abrir el archivo %s\n", nomArchivo);
+        exit(1);
+    }
+    char linea[300];
+    int cont = 0;
+    while (fgets(linea, sizeof(linea), archivo) && cont < MAX_OPS_CARGA) {
+        if (linea[0] == '\n' || linea[0] == '\0') continue;
+        if (sscanf(linea, "%c, %249[^,], %d", &ops[cont].tipo, ops[cont].nombre, &ops[cont].isbn) != 3) {
+            printf("Error al leer la línea: %s", linea);
+            continue;
+        }
+        // La terminación la manda el generador al final, no cada cliente
+        if (ops[cont].tipo == 'Q') continue;
+        cont++;
+    }
+    fclose(archivo);
+    return cont;
+}
+
+// Lanza el receptor como proceso hijo. Su consola queda conectada a fdControl para poder mandarle 's'.
+// extra trae opciones adicionales para el receptor separadas por espacios (o NULL)
+pid_t lanzarReceptor(char *receptor, char *fileDatos, char *fileSalida, char *extra, char *fileLog, int *fdControl) {
+    int control[2];
+    if (pipe(control) == -1) {
+        printf("Error al crear el pipe de control\n");
+        exit(1);
+    }
+    unlink(PIPE_CARGA);
+    pid_t pid = fork();
+    if (pid < 0) {
+        printf("Error al crear el proceso receptor\n");
+        exit(1);
+    } else if (pid == 0) {
+        // La consola del receptor se lee del pipe de control y la salida va al log
+        dup2(control[0], STDIN_FILENO);
+        close(control[0]);
+        close(control[1]);
+        int fdLog = open(fileLog, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fdLog >= 0) {
+            dup2(fdLog, STDOUT_FILENO);
+            dup2(fdLog, STDERR_FILENO);
+            close(fdLog);
+        }
+        char *args[MAX_ARGS_RECEPTOR + 8];
+        int n = 0;
+        args[n++] = receptor;
+        args[n++] = "-p";
+        args[n++] = PIPE_CARGA;
+        args[n++] = "-f";
+        args[n++] = fileDatos;
+        if (fileSalida) {
+            args[n++] = "-s";
+            args[n++] = fileSalida;
+        }
+        for (char *opcion = extra ? strtok(extra, " ") : NULL; opcion && n < MAX_ARGS_RECEPTOR + 7; opcion = strtok(NULL, " ")) {
+            args[n++] = opcion;
+        }
+        args[n] = NULL;
+        execv(receptor, args);
+        perror("execv");
+        _exit(1);
+    }
+    close(control[0]);
+    *fdControl = control[1];
+    return pid;
+}
+
+// Espera una respuesta completa (terminada en '\0') y devuelve el tiempo en que llegó, o -1 si se agotó el tiempo.
+// El receptor puede escribir varias respuestas de un mismo cliente en una sola escritura, así que lo
+// que llegue después del '\0' se guarda para la siguiente llamada
+long long esperarRespuesta(int fdResp) {
+    static char pendiente[2 * MAX_RESPUESTA];
+    static int total = 0;
+    long long limite = ahoraNs() + (long long)TIMEOUT_RESPUESTA_MS * 1000000LL;
+    while (1) {
+        char *fin = memchr(pendiente, '\0', total);
+        if (fin || total == (int)sizeof(pendiente)) {
+            int largo = fin ? fin - pendiente + 1 : total;
+            memmove(pendiente, pendiente + largo, total - largo);
+            total -= largo;
+            return ahoraNs();
+        }
+        int restante = (int)((limite - ahoraNs()) / 1000000LL);
+        if (restante <= 0) return -1;
+        struct pollfd pfd = {fdResp, POLLIN, 0};
+        if (poll(&pfd, 1, restante) <= 0) return -1;
+        int bytes = read(fdResp, pendiente + total, sizeof(pendiente) - total);
+        if (bytes <= 0) return -1;
+        total += bytes;
+    }
+}
+
+// Espera la respuesta de la trama más antigua en vuelo y guarda la latencia de sus operaciones.
+// Si no llega, el tiempo que se esperó en vano se suma a perdidoNs
+static void recibirEnVuelo(int fdResp, struct EnVuelo *vuelo, int ventana, int *primera, int *enVuelo, long long *latencias, long long *perdidoNs) {
+    long long espera = ahoraNs();
+    long long fin = esperarRespuesta(fdResp);
+    if (fin < 0) {
+        *perdidoNs += ahoraNs() - espera;
+    }
+    struct EnVuelo *v = &vuelo[*primera];
+    for (int k = 0; k < v->num; k++) {
+        latencias[v->indices[k]] = fin < 0 ? -1 : fin - v->inicio;
+    }
+    *primera = (*primera + 1) % ventana;
+    (*enVuelo)--;
+}
+
+// Cuerpo de cada cliente: envía las operaciones de su partición y guarda la latencia de cada una.
+// Las operaciones se reparten por ISBN, así cada libro es atendido por un único cliente en orden
+// y el estado final no depende del intercalado entre clientes. Con tamLote > 1 se agrupan en
+// tramas "M,n,pid" y cada operación del lote recibe la latencia del lote completo. Con ventana > 1
+// se mandan hasta ventana tramas antes de esperar la respuesta de la más antigua. En tiempos deja
+// cuánto esperó respuestas que no llegaron y el instante en que terminó
+void cliente(int fd, struct OpCarga *ops, int numOps, int id, int numClientes, int repeticiones, int tamLote, int ventana, long long *latencias, struct TiemposCliente *tiempos) {
+    pid_t pid = getpid();
+    char pipeRecibe[20];
+    snprintf(pipeRecibe, sizeof(pipeRecibe), "pipe_%d", pid);
+    if (mkfifo(pipeRecibe, 0666) == -1 && errno != EEXIST) {
+        printf("Error al crear el pipe de respuesta %s\n", pipeRecibe);
+        exit(1);
+    }
+    int fdResp = open(pipeRecibe, O_RDWR);
+    if (fdResp < 0) {
+        printf("Error al abrir el pipe de respuesta %s\n", pipeRecibe);
+        unlink(pipeRecibe);
+        exit(1);
+    }
+    // Tramas enviadas que esperan respuesta, de la más antigua a la más nueva
+    struct EnVuelo *vuelo = malloc(sizeof(struct EnVuelo) * ventana);
+    int primera = 0, enVuelo = 0;
+    char mensaje[PIPE_BUF];
+    for (int r = 0; r < repeticiones; r++) {
+        int i = 0;
+        while (i < numOps) {
+            // Se arma la siguiente trama con hasta tamLote operaciones de la partición
+            struct EnVuelo *v = &vuelo[(primera + enVuelo) % ventana];
+            int num = 0, largo = 0;
+            for (; i < numOps && num < tamLote; i++) {
+                if (ops[i].isbn % numClientes != id) continue;
+                if (tamLote > 1 && largo + (int)strlen(ops[i].nombre) + 20 >= PIPE_BUF) break;
+                if (tamLote == 1) {
+                    largo = snprintf(mensaje, sizeof(mensaje), "%c,%s,%d,%d", ops[i].tipo, ops[i].nombre, ops[i].isbn, pid);
+                } else {
+                    if (num == 0) largo = snprintf(mensaje, sizeof(mensaje), "M,%03d,%d", 0, pid);
+                    largo += snprintf(mensaje + largo, sizeof(mensaje) - largo, "\n%c,%s,%d", ops[i].tipo, ops[i].nombre, ops[i].isbn);
+                }
+                v->indices[num++] = (long)r * numOps + i;
+            }
+            if (num == 0) continue;
+            if (tamLote > 1) {
+                // El número de operaciones se escribe al final sobre el espacio reservado
+                char cuenta[4];
+                snprintf(cuenta, sizeof(cuenta), "%03d", num);
+                memcpy(mensaje + 2, cuenta, 3);
+            }
+            v->num = num;
+            v->inicio = ahoraNs();
+            write(fd, mensaje, largo + 1);
+            // Con la ventana llena se espera la respuesta de la trama más antigua
+            if (++enVuelo == ventana) {
+                recibirEnVuelo(fdResp, vuelo, ventana, &primera, &enVuelo, latencias, &tiempos->perdidoNs);
+            }
+        }
+    }
+    while (enVuelo > 0) {
+        recibirEnVuelo(fdResp, vuelo, ventana, &primera, &enVuelo, latencias, &tiempos->perdidoNs);
+    }
+    tiempos->finNs = ahoraNs();
+    free(vuelo);
+    close(fdResp);
+    unlink(pipeRecibe);
+}
+
+// Cliente interactivo: mientras los demás corren manda una consulta (C) sola cada intervaloMs sobre
+// los libros de la carga, como alguien usando el menú, y guarda su latencia. Las consultas no
+// cambian el estado final, así la corrida sigue siendo comparable con las demás
+void interactivo(int fd, struct OpCarga *ops, int numOps, int intervaloMs, volatile int *fin, long long *latencias, long *numLatencias) {
+    pid_t pid = getpid();
+    char pipeRecibe[20];
+    snprintf(pipeRecibe, sizeof(pipeRecibe), "pipe_%d", pid);
+    if (mkfifo(pipeRecibe, 0666) == -1 && errno != EEXIST) {
+        printf("Error al crear el pipe de respuesta %s\n", pipeRecibe);
+        exit(1);
+    }
+    int fdResp = open(pipeRecibe, O_RDWR);
+    if (fdResp < 0) {
+        printf("Error al abrir el pipe de respuesta %s\n", pipeRecibe);
+        unlink(pipeRecibe);
+        exit(1);
+    }
+    long n = 0;
+    for (int i = 0; !*fin && n < MAX_OPS_CARGA; i = (i + 1) % numOps) {
+        char mensaje[300];
+        int largo = snprintf(mensaje, sizeof(mensaje), "C,%s,%d,%d", ops[i].nombre, ops[i].isbn, pid);
+        long long inicio = ahoraNs();
+        write(fd, mensaje, largo + 1);
+        long long llegada = esperarRespuesta(fdResp);
+        latencias[n++] = llegada < 0 ? -1 : llegada - inicio;
+        usleep(intervaloMs * 1000);
+    }
+    *numLatencias = n;
+    close(fdResp);
+    unlink(pipeRecibe);
+}
+
+// Compara dos latencias para qsort
+static int compararLatencias(const void *a, const void *b) {
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+// Ordena las latencias válidas y calcula los percentiles en microsegundos
+void calcularResultado(long long *latencias, long total, struct Resultado *res) {
+    long long *validas = malloc(sizeof(long long) * (total > 0 ? total : 1));
+    long n = 0;
+    for (long i = 0; i < total; i++) {
+        if (latencias[i] >= 0) {
+            validas[n++] = latencias[i];
+        }
+    }
+    res->ops = n;
+    res->perdidas = total - n;
+    qsort(validas, n, sizeof(long long), compararLatencias);
+    if (n > 0) {
+        res->p50 = validas[(n - 1) * 50 / 100] / 1000.0;
+        res->p95 = validas[(n - 1) * 95 / 100] / 1000.0;
+        res->p99 = validas[(n - 1) * 99 / 100] / 1000.0;
+        res->max = validas[n - 1] / 1000.0;
+    }
+    free(validas);
+}
+
+// Proceso principal del generador de carga
+int main(int argc, char *argv[]) {
+    char *receptor = NULL;
+    char *fileDatos = NULL;
+    char *fileCarga = NULL;
+    char *fileSalida = NULL;
+    char *etiqueta = "receptor";
+    int numClientes = 4;
+    int repeticiones = 1;
+    int tamLote = 1;
+    int ventana = 1;
+    char *extra = NULL;
+    int intervaloInteractivo = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            receptor = argv[++i];
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            fileDatos = argv[++i];
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            fileCarga = argv[++i];
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            fileSalida = argv[++i];
+        } else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+            etiqueta = argv[++i];
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            numClientes = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            repeticiones = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            tamLote = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            ventana = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            extra = argv[++i];
+        } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
+            intervaloInteractivo = atoi(argv[++i]);
+        }
+    }
+
+    if (!receptor || !fileDatos || !fileCarga || numClientes < 1 || numClientes > MAX_CLIENTES || repeticiones < 1 || tamLote < 1 || tamLote > MAX_LOTE || ventana < 1 || ventana > MAX_VENTANA) {
+        printf("\n \t\tUse: $./carga -r receptor -f filedatos -w filecarga [-c clientes] [-n repeticiones] [-b tamLote] [-o ventana] [-s filesalida] [-e etiqueta] [-x \"opciones del receptor\"] [-i intervaloMs]\n");
+        exit(1);
+    }
+
+    struct OpCarga *ops = malloc(sizeof(struct OpCarga) * MAX_OPS_CARGA);
+    int numOps = leerCarga(fileCarga, ops);
+    if (numOps <= 0) {
+        printf("La carga %s no tiene operaciones\n", fileCarga);
+        exit(1);
+    }
+
+    // Latencias en memoria compartida, cada cliente escribe solo las posiciones de su partición
+    long total = (long)numOps * repeticiones;
+    long long *latencias = mmap(NULL, sizeof(long long) * total, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (latencias == MAP_FAILED) {
+        printf("Error al reservar memoria para las latencias\n");
+        exit(1);
+    }
+    for (long i = 0; i < total; i++) latencias[i] = -1;
+    // Con -i, latencias del cliente interactivo, cuántas guardó y la marca de que los demás terminaron
+    // Tiempos de cada cliente, compartidos con los procesos hijos
+    struct TiemposCliente *tiempos = mmap(NULL, sizeof(struct TiemposCliente) * MAX_CLIENTES, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (tiempos == MAP_FAILED) {
+        printf("Error al reservar memoria para los tiempos de los clientes\n");
+        exit(1);
+    }
+    long long *latenciasInt = NULL;
+    long *numInt = NULL;
+    volatile int *fin = NULL;
+    if (intervaloInteractivo > 0) {
+        size_t tam = sizeof(long long) * MAX_OPS_CARGA + sizeof(long) + sizeof(int);
+        latenciasInt = mmap(NULL, tam, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (latenciasInt == MAP_FAILED) {
+            printf("Error al reservar memoria para las latencias\n");
+            exit(1);
+        }
+        numInt = (long *)(latenciasInt + MAX_OPS_CARGA);
+        fin = (volatile int *)(numInt + 1);
+    }
+
+    // Se lanza el receptor y se espera a que cree su pipe
+    char fileLog[300];
+    snprintf(fileLog, sizeof(fileLog), "receptor_%s.log", etiqueta);
+    int fdControl;
+    pid_t pidReceptor = lanzarReceptor(receptor, fileDatos, fileSalida, extra, fileLog, &fdControl);
+    struct stat st;
+    int espera = 500;
+    while (stat(PIPE_CARGA, &st) == -1 && espera-- > 0) {
+        usleep(10000);
+    }
+    int fd = open(PIPE_CARGA, O_WRONLY);
+    if (fd < 0) {
+        printf("Error al abrir el pipe %s\n", PIPE_CARGA);
+        kill(pidReceptor, SIGKILL);
+        exit(1);
+    }
+    // Se da tiempo a que el receptor termine de cargar la base de datos
+    usleep(200000);
+
+    // Se lanzan los clientes y se mide el tiempo total
+    long long inicio = ahoraNs();
+    pid_t clientes[MAX_CLIENTES];
+    pid_t pidInteractivo = 0;
+    if (intervaloInteractivo > 0) {
+        pidInteractivo = fork();
+        if (pidInteractivo == 0) {
+            interactivo(fd, ops, numOps, intervaloInteractivo, fin, latenciasInt, numInt);
+            _exit(0);
+        }
+    }
+    for (int k = 0; k < numClientes; k++) {
+        clientes[k] = fork();
+        if (clientes[k] == 0) {
+            cliente(fd, ops, numOps, k, numClientes, repeticiones, tamLote, ventana, latencias, &tiempos[k]);
+            _exit(0);
+        }
+    }
+    for (int k = 0; k < numClientes; k++) {
+        waitpid(clientes[k], NULL, 0);
+    }
+    long long termino = ahoraNs();
+    if (pidInteractivo > 0) {
+        *fin = 1;
+        waitpid(pidInteractivo, NULL, 0);
+    }
+
+    // Se termina el receptor de forma ordenada: Q por el pipe y 's' por consola
+    char mensaje[64];
+    snprintf(mensaje, sizeof(mensaje), "Q,Salir,0,%d", getpid());
+    write(fd, mensaje, strlen(mensaje) + 1);
+    usleep(100000);
+    write(fdControl, "s\n", 2);
+    close(fdControl);
+    struct rusage uso;
+    int estado;
+    wait4(pidReceptor, &estado, 0, &uso);
+    close(fd);
+    unlink(PIPE_CARGA);
+
+    struct Resultado res = {0};
+    calcularResultado(latencias, total, &res);
+    res.segundos = (termino - inicio) / 1e9;
+    //El throughput no cuenta el tiempo esperando respuestas perdidas: el final de cada cliente se
+    //adelanta lo que esperó en vano y la corrida útil termina con el último. Sin pérdidas es la duración
+    long long finUtil = 0;
+    for (int k = 0; k < numClientes; k++) {
+        long long fin = tiempos[k].finNs - tiempos[k].perdidoNs;
+        if (fin > finUtil) finUtil = fin;
+    }
+    res.segundosUtiles = finUtil > inicio ? (finUtil - inicio) / 1e9 : res.segundos;
+    res.cpuUsuario = uso.ru_utime.tv_sec + uso.ru_utime.tv_usec / 1e6;
+    res.cpuSistema = uso.ru_stime.tv_sec + uso.ru_stime.tv_usec / 1e6;
+    res.rssKb = uso.ru_maxrss;
+
+    // Una línea por corrida para que comparar.sh arme la tabla
+    printf("%-10s %8ld %8.3f %10.1f %9.1f %9.1f %9.1f %9.1f %8.3f %8.3f %8ld %8ld\n",
+           etiqueta, res.ops, res.segundos, res.ops / res.segundosUtiles, res.p50, res.p95, res.p99, res.max,
+           res.cpuUsuario, res.cpuSistema, res.rssKb, res.perdidas);
+    // El interactivo va en su propia línea, sin CPU ni memoria porque son las del mismo receptor
+    if (intervaloInteractivo > 0) {
+        struct Resultado resInt = {0};
+        calcularResultado(latenciasInt, *numInt, &resInt);
+        char etiquetaInt[64];
+        snprintf(etiquetaInt, sizeof(etiquetaInt), "%s-int", etiqueta);
+        printf("%-10s %8ld %8.3f %10.1f %9.1f %9.1f %9.1f %9.1f %8s %8s %8s %8ld\n",
+               etiquetaInt, resInt.ops, res.segundos, resInt.ops / res.segundos, resInt.p50, resInt.p95, resInt.p99, resInt.max,
+               "-", "-", "-", resInt.perdidas);
+        munmap(latenciasInt, sizeof(long long) * MAX_OPS_CARGA + sizeof(long) + sizeof(int));
+    }
+
+    munmap(tiempos, sizeof(struct TiemposCliente) * MAX_CLIENTES);
+    munmap(latencias, sizeof(long long) * total);
+    free(ops);
+    return 0;
+}
@@ -0,0 +1,67 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: carga.h
+#	Descripcion: Archivo de encabezado para carga.c.
+#                Define las estructuras y prototipos del generador de carga usado para comparar los receptores
+#****************************************************************/
+
+#ifndef CARGA_H
+#define CARGA_H
+
+#include <sys/types.h>
+
+#define MAX_OPS_CARGA 100000
+#define MAX_CLIENTES 64
+#define TIMEOUT_RESPUESTA_MS 2000
+#define PIPE_CARGA "pipeCarga"
+#define MAX_LOTE 64
+#define MAX_RESPUESTA 8192
+// Tramas que un cliente puede tener enviadas sin respuesta (-o)
+#define MAX_VENTANA 64
+// Opciones adicionales que se le pueden pasar al receptor con -x
+#define MAX_ARGS_RECEPTOR 16
+
+// Representa una operación de la carga grabada (mismo formato que operaciones.txt)
+struct OpCarga {
+    char tipo;
+    char nombre[250];
+    int isbn;
+};
+
+// Trama enviada que espera respuesta, con el instante de envío y las operaciones que lleva
+struct EnVuelo {
+    long long inicio;
+    int num;
+    long indices[MAX_LOTE];
+};
+
+// Resultado agregado de una corrida
+struct Resultado {
+    long ops;
+    long perdidas;
+    double segundos;
+    double segundosUtiles; // Duración sin el tiempo esperando respuestas que no llegaron
+    double p50, p95, p99, max;
+    double cpuUsuario, cpuSistema;
+    long rssKb;
+};
+
+// Tiempos de un cliente de la carga, en nanosegundos monotónicos
+struct TiemposCliente {
+    long long perdidoNs; // Tiempo esperando respuestas que no llegaron
+    long long finNs;     // Instante en que terminó
+};
+
+// Funciones del generador de carga
+int leerCarga(char *nomArchivo, struct OpCarga *ops);
+pid_t lanzarReceptor(char *receptor, char *fileDatos, char *fileSalida, char *extra, char *fileLog, int *fdControl);
+void cliente(int fd, struct OpCarga *ops, int numOps, int id, int numClientes, int repeticiones, int tamLote, int ventana, long long *latencias, struct TiemposCliente *tiempos);
+void interactivo(int fd, struct OpCarga *ops, int numOps, int intervaloMs, volatile int *fin, long long *latencias, long *numLatencias);
+long long esperarRespuesta(int fdResp);
+void calcularResultado(long long *latencias, long total, struct Resultado *res);
+
+#endif
@@ -0,0 +1,74 @@
+#!/bin/sh
+#**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: comparar.sh
+#	Descripcion: Compila el receptor POSIX y el unificado, los alimenta con la misma carga y el
+#                mismo número de clientes (el unificado con sus modelos omp y fork) y compara los
+#                resultados y el estado final (-s).
+#               Uso: ./comparar.sh [clientes] [repeticiones] [filecarga] [filedatos]
+#****************************************************************
+
+CLIENTES=${1:-4}
+REPETICIONES=${2:-5}
+CARGA=${3:-carga.txt}
+DATOS=${4:-basedatos.txt}
+DIR=$(cd "$(dirname "$0")" && pwd)
+cd "$DIR" || exit 1
+
+# Se compilan los dos receptores y el generador de carga
+make -s carga receptores || exit 1
+
+echo "Clientes: $CLIENTES, repeticiones: $REPETICIONES, carga: $CARGA, base de datos: $DATOS"
+printf "%-10s %8s %8s %10s %9s %9s %9s %9s %8s %8s %8s %8s\n" \
+    variante ops seg ops/s p50_us p95_us p99_us max_us cpu_usr cpu_sis rss_kb perdidas
+# Variantes con operaciones sin respuesta o con un estado final distinto al de los otros modelos
+FALLOS=""
+marcarFallo() {
+    case "$FALLOS " in
+        *" $1 "*) ;;
+        *) FALLOS="$FALLOS $1" ;;
+    esac
+}
+for VARIANTE in POSIX omp fork; do
+    rm -f pipe_*
+    if [ "$VARIANTE" = "POSIX" ]; then
+        RECEPTOR=../POSIX/receptor
+        OPCIONES=""
+    else
+        RECEPTOR=../Unificado/receptor
+        OPCIONES="-m $VARIANTE"
+    fi
+    LINEA=$(./carga -r "$RECEPTOR" -f "$DATOS" -w "$CARGA" -c "$CLIENTES" -n "$REPETICIONES" \
+        -s "salida_$VARIANTE.txt" -x "$OPCIONES" -e "$VARIANTE" | tail -n 1)
+    echo "$LINEA"
+    PERDIDAS=$(echo "$LINEA" | awk '{print $NF}')
+    if [ "$PERDIDAS" != "0" ]; then
+        marcarFallo "$VARIANTE"
+        echo "  ATENCIÓN: $VARIANTE dejó $PERDIDAS operaciones sin respuesta; sus latencias y su estado final no son comparables"
+    fi
+done
+
+# Los dos receptores devuelven y renuevan el ejemplar del solicitante (ejemplarDe), así que el
+# estado final se exige igual entre los modelos y también contra POSIX
+echo "Estado final (-s):"
+if cmp -s salida_omp.txt salida_fork.txt; then
+    echo "  fork contra omp: igual"
+else
+    marcarFallo fork
+    echo "  fork contra omp: DIFERENTE ($(diff salida_omp.txt salida_fork.txt | grep -c '^[<>]') líneas)"
+fi
+if cmp -s salida_POSIX.txt salida_omp.txt; then
+    echo "  unificado contra POSIX: igual"
+else
+    marcarFallo omp
+    echo "  unificado contra POSIX: DIFERENTE ($(diff salida_POSIX.txt salida_omp.txt | grep -c '^[<>]') líneas)"
+fi
+
+if [ -n "$FALLOS" ]; then
+    echo "ATENCIÓN: los resultados de$FALLOS no son equivalentes"
+    exit 1
+fi
@@ -0,0 +1,35 @@
+#!/bin/sh
+#**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: equidad.sh
+#	Descripcion: Mide la latencia de un cliente interactivo (una consulta cada pocos ms) mientras
+#                varios clientes masivos mandan la carga en lotes de 64, con el receptor POSIX sin
+#                planificador, con turnos por solicitante (-d) y con turnos más fichas (-t).
+#               Uso: ./equidad.sh [clientes] [repeticiones] [intervaloMs] [tasa] [filecarga] [filedatos]
+#****************************************************************
+
+CLIENTES=${1:-8}
+REPETICIONES=${2:-400}
+INTERVALO=${3:-1}
+TASA=${4:-20000}
+CARGA=${5:-carga.txt}
+DATOS=${6:-basedatos.txt}
+DIR=$(cd "$(dirname "$0")" && pwd)
+cd "$DIR" || exit 1
+
+make -s carga && make -s -C ../POSIX receptor || exit 1
+
+echo "Clientes masivos: $CLIENTES (lotes de 64), repeticiones: $REPETICIONES, interactivo cada $INTERVALO ms, tasa: $TASA ops/s"
+printf "%-10s %8s %8s %10s %9s %9s %9s %9s %8s %8s %8s %8s\n" \
+    config ops seg ops/s p50_us p95_us p99_us max_us cpu_usr cpu_sis rss_kb perdidas
+for CONFIG in "fifo:" "turnos:-d 4" "fichas:-d 4 -t $TASA:64"; do
+    ETIQUETA=${CONFIG%%:*}
+    OPCIONES=${CONFIG#*:}
+    rm -f pipe_*
+    ./carga -r ../POSIX/receptor -f "$DATOS" -w "$CARGA" -c "$CLIENTES" -n "$REPETICIONES" -b 64 \
+        -i "$INTERVALO" -x "$OPCIONES" -e "$ETIQUETA"
+done
@@ -0,0 +1,39 @@
+#!/bin/sh
+#**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: escrituras.sh
+#	Descripcion: Mide las llamadas al sistema por respuesta del receptor POSIX con clientes que
+#                mandan varias operaciones sin esperar (-o), escribiendo una respuesta por writev
+#                y juntando las pendientes de cada cliente sin espera y con espera de 200 us.
+#               Uso: ./escrituras.sh [clientes] [repeticiones] [ventana] [filecarga] [filedatos]
+#****************************************************************
+
+CLIENTES=${1:-8}
+REPETICIONES=${2:-20}
+VENTANA=${3:-16}
+CARGA=${4:-carga.txt}
+DATOS=${5:-basedatos.txt}
+DIR=$(cd "$(dirname "$0")" && pwd)
+cd "$DIR" || exit 1
+
+make -s carga && make -s -C ../POSIX receptor || exit 1
+
+echo "Clientes: $CLIENTES, repeticiones: $REPETICIONES, ventana: $VENTANA operaciones sin respuesta por cliente"
+printf "%-10s %8s %8s %10s %9s %9s %9s %9s %8s %8s %8s %8s %10s\n" \
+    config ops seg ops/s p50_us p95_us p99_us max_us cpu_usr cpu_sis rss_kb perdidas llamadas/op
+for CONFIG in "una:-j 0:1" "juntas:-j 0" "juntas200:-j 200"; do
+    ETIQUETA=${CONFIG%%:*}
+    OPCIONES=${CONFIG#*:}
+    rm -f pipe_* "stats_$ETIQUETA.txt"
+    LINEA=$(./carga -r ../POSIX/receptor -f "$DATOS" -w "$CARGA" -c "$CLIENTES" -n "$REPETICIONES" -o "$VENTANA" \
+        -x "$OPCIONES -e stats_$ETIQUETA.txt" -e "$ETIQUETA")
+    # open + close + writev de los escritores por respuesta entregada
+    LLAMADAS=$(awk '/^biblioteca_respuesta_llamadas_total/ { llamadas += $2 }
+                    /^biblioteca_respuestas_escritas_total/ { escritas = $2 }
+                    END { if (escritas > 0) printf "%.3f", llamadas / escritas; else print "-" }' "stats_$ETIQUETA.txt")
+    echo "$LINEA $(printf '%10s' "$LLAMADAS")"
+done
@@ -0,0 +1,39 @@
+#!/bin/sh
+#**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: lotes.sh
+#	Descripcion: Mide el receptor POSIX con la misma carga enviada operación por operación
+#                y en lotes de 8 y 64 operaciones por trama.
+#               Uso: ./lotes.sh [clientes] [repeticiones] [filecarga] [filedatos]
+#****************************************************************
+
+CLIENTES=${1:-4}
+REPETICIONES=${2:-5}
+CARGA=${3:-carga.txt}
+DATOS=${4:-basedatos.txt}
+DIR=$(cd "$(dirname "$0")" && pwd)
+cd "$DIR" || exit 1
+
+make -s carga && make -s -C ../POSIX receptor || exit 1
+
+echo "Clientes: $CLIENTES, repeticiones: $REPETICIONES, carga: $CARGA, base de datos: $DATOS"
+printf "%-10s %8s %8s %10s %9s %9s %9s %9s %8s %8s %8s %8s\n" \
+    lote ops seg ops/s p50_us p95_us p99_us max_us cpu_usr cpu_sis rss_kb perdidas
+for LOTE in 1 8 64; do
+    rm -f pipe_*
+    ./carga -r ../POSIX/receptor -f "$DATOS" -w "$CARGA" -c "$CLIENTES" -n "$REPETICIONES" -b "$LOTE" \
+        -s "salida_lote$LOTE.txt" -e "lote$LOTE"
+done
+
+# Agrupar no debe cambiar el resultado: el orden por ISBN se mantiene
+for LOTE in 8 64; do
+    if cmp -s salida_lote1.txt "salida_lote$LOTE.txt"; then
+        echo "  lote $LOTE: estado final igual al de lote 1"
+    else
+        echo "  lote $LOTE: estado final DIFERENTE al de lote 1"
+    fi
+done
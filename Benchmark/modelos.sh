@@ -0,0 +1,42 @@
+#!/bin/sh
+#**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: modelos.sh
+#	Descripcion: Compara los modelos de concurrencia del receptor unificado (-m posix, omp, fork
+#                y sharded) con la misma carga, el mismo binario y el mismo número de hilos, y
+#                verifica que todos terminen con el mismo estado final.
+#               Uso: ./modelos.sh [clientes] [repeticiones] [hilos] [filecarga] [filedatos]
+#****************************************************************
+
+CLIENTES=${1:-4}
+REPETICIONES=${2:-5}
+HILOS=${3:-4}
+CARGA=${4:-carga.txt}
+DATOS=${5:-basedatos.txt}
+DIR=$(cd "$(dirname "$0")" && pwd)
+cd "$DIR" || exit 1
+
+make -s carga && make -s -C ../Unificado receptor || exit 1
+
+echo "Clientes: $CLIENTES, repeticiones: $REPETICIONES, hilos: $HILOS, carga: $CARGA, base de datos: $DATOS"
+printf "%-10s %8s %8s %10s %9s %9s %9s %9s %8s %8s %8s %8s\n" \
+    modelo ops seg ops/s p50_us p95_us p99_us max_us cpu_usr cpu_sis rss_kb perdidas
+for MODELO in posix omp fork sharded; do
+    rm -f pipe_*
+    ./carga -r ../Unificado/receptor -f "$DATOS" -w "$CARGA" -c "$CLIENTES" -n "$REPETICIONES" \
+        -s "salida_$MODELO.txt" -x "-m $MODELO -n $HILOS" -e "$MODELO"
+done
+
+# Todos los modelos aplican las operaciones de cada libro en orden, el estado final debe ser el mismo
+echo "Estado final (-s) comparado con posix:"
+for MODELO in omp fork sharded; do
+    if cmp -s salida_posix.txt "salida_$MODELO.txt"; then
+        echo "  $MODELO: igual"
+    else
+        echo "  $MODELO: DIFERENTE ($(diff salida_posix.txt "salida_$MODELO.txt" | grep -c '^[<>]') líneas)"
+    fi
+done
@@ -0,0 +1,112 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: nucleo.c
+#	Descripcion: Mide el núcleo del catálogo (libbiblioteca) sin receptor, pipes ni hilos: carga la
+#                base de datos y aplica la carga grabada en el mismo proceso, así se ve cuánto
+#                cuesta cada operación por sí sola y cuánto de lo que mide carga es transporte.
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "nucleo.h"
+
+static const char *nombresResultados[NUM_RESULTADOS] = {"exito", "no_encontrado", "sin_ejemplar", "sin_prestamo", "invalida"};
+
+// Devuelve el tiempo monotónico actual en nanosegundos
+static long long ahoraNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Lee la carga grabada con el mismo formato de operaciones.txt (Operación, Libro, ISBN), sin las Q
+int leerCarga(char *nomArchivo, struct OpNucleo *ops) {
+    FILE *archivo = fopen(nomArchivo, "r");
+    if (!archivo) {
+        printf("Error al abrir el archivo %s\n", nomArchivo);
+        exit(1);
+    }
+    char linea[300];
+    int cont = 0;
+    while (fgets(linea, sizeof(linea), archivo) && cont < MAX_OPS_NUCLEO) {
+        if (linea[0] == '\n' || linea[0] == '\0') continue;
+        if (sscanf(linea, "%c, %249[^,], %d", &ops[cont].tipo, ops[cont].nombre, &ops[cont].isbn) != 3) {
+            printf("Error al leer la línea: %s", linea);
+            continue;
+        }
+        if (ops[cont].tipo == 'Q') continue;
+        cont++;
+    }
+    fclose(archivo);
+    return cont;
+}
+
+int main(int argc, char *argv[]) {
+    char *fileDatos = NULL;
+    char *fileCarga = NULL;
+    char *fileSalida = NULL;
+    int repeticiones = 1000;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            fileDatos = argv[++i];
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            fileCarga = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            repeticiones = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            fileSalida = argv[++i];
+        }
+    }
+
+    if (!fileDatos || !fileCarga || repeticiones < 1) {
+        printf("\n \t\tUse: $./nucleo -f filedatos -w filecarga [-n repeticiones] [-s filesalida]\n");
+        exit(1);
+    }
+
+    static struct Libros libros[MAX_LIBROS];
+    int numLibros = cargarLibros(fileDatos, libros, MAX_LIBROS, NULL);
+    if (numLibros <= 0) {
+        printf("Error cargando la base de datos %s\n", fileDatos);
+        exit(1);
+    }
+    struct OpNucleo *ops = malloc(sizeof(struct OpNucleo) * MAX_OPS_NUCLEO);
+    if (!ops) {
+        printf("Error al reservar memoria para la carga\n");
+        exit(1);
+    }
+    int numOps = leerCarga(fileCarga, ops);
+    if (numOps == 0) {
+        printf("La carga %s no tiene operaciones\n", fileCarga);
+        exit(1);
+    }
+
+    //Se aplica la carga completa repeticiones veces sobre el mismo catálogo, como un receptor sin pausas
+    long resultados[NUM_RESULTADOS] = {0};
+    long long inicio = ahoraNs();
+    for (int r = 0; r < repeticiones; r++) {
+        for (int k = 0; k < numOps; k++) {
+            struct ResultadoBib res = aplicarOperacion(libros, numLibros, ops[k].tipo, ops[k].isbn, ops[k].nombre, 0);
+            resultados[res.codigo]++;
+        }
+    }
+    long long total = ahoraNs() - inicio;
+    long operaciones = (long)numOps * repeticiones;
+
+    printf("Núcleo: %d libros, %ld operaciones (%d x %d) en %.3f s\n", numLibros, operaciones, numOps, repeticiones, total / 1e9);
+    printf("Throughput: %.0f ops/s, %.1f ns por operación\n", operaciones / (total / 1e9), (double)total / operaciones);
+    for (int c = 0; c < NUM_RESULTADOS; c++) {
+        printf("  %-14s %ld\n", nombresResultados[c], resultados[c]);
+    }
+    if (fileSalida && !guardarLibros(fileSalida, libros, numLibros)) {
+        printf("Error al crear el archivo de salida\n");
+    }
+    free(ops);
+    return 0;
+}
@@ -0,0 +1,28 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: nucleo.h
+#	Descripcion: Archivo de encabezado para nucleo.c.
+#                Define las operaciones de la carga con las que se mide libbiblioteca sin pipes
+#****************************************************************/
+
+#ifndef NUCLEO_H
+#define NUCLEO_H
+
+#include "libbiblioteca.h"
+
+#define MAX_OPS_NUCLEO 100000
+// Códigos de resultado de libbiblioteca, de BIB_EXITO a BIB_OPERACION_INVALIDA
+#define NUM_RESULTADOS 5
+
+// Representa una operación de la carga grabada (mismo formato que operaciones.txt)
+struct OpNucleo {
+    char tipo;
+    char nombre[250];
+    int isbn;
+};
+
+#endif
@@ -0,0 +1,281 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: administracion.c
+#	Descripcion: Pipe de administración del receptor. Solo el usuario dueño del receptor puede
+#                escribir en él (permisos 0600) y por ahí llegan las altas "A,nombre,isbn,cantidad",
+#                que agregan un libro o ejemplares sin detener las demás operaciones, dejan el
+#                cambio guardado en el archivo de la base de datos y, con p=pid, le responden al
+#                administrador.
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include "administracion.h"
+#include "biblioteca.h"
+#include "metricas.h"
+#include "bitacora.h"
+#include "respuestas.h"
+
+// Crea (o reutiliza) el pipe de administración y lo abre para lectura. Se rechaza si no es un FIFO
+// del mismo usuario del receptor o si otros usuarios pueden abrirlo, porque ese permiso es lo único
+// que autentica al administrador. Devuelve el descriptor o -1
+int abrirPipeAdmin(const char *nombre) {
+    if (mkfifo(nombre, 0600) == -1 && errno != EEXIST) {
+        printf("Error al crear el pipe de administración %s\n", nombre);
+        return -1;
+    }
+    // Se abre en lectura/escritura para no recibir EOF cuando el administrador cierra su extremo
+    int fd = open(nombre, O_RDWR);
+    if (fd < 0) {
+        printf("Error al abrir el pipe de administración %s\n", nombre);
+        return -1;
+    }
+    struct stat info;
+    if (fstat(fd, &info) == -1 || !S_ISFIFO(info.st_mode) || info.st_uid != geteuid() || (info.st_mode & 077) != 0) {
+        printf("Error: %s debe ser un FIFO del usuario del receptor con permisos 0600\n", nombre);
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Agrega cantidad ejemplares disponibles al libro isbn o, si no existe, lo da de alta con esa
+// cantidad. Los ejemplares de un libro existente se agregan en su lugar con mutexLibros tomado: B y C
+// no leen los ejemplares y P, D y R los ven al tomar el mutex. Si el libro tiene reservas, los
+// ejemplares nuevos pasan directo a los primeros de la lista. Un libro nuevo cambia las tablas que B
+// y C leen sin mutex, así que se publica en un catálogo nuevo igual que en una recarga. Devuelve 1 si
+// tuvo éxito
+int aplicarAlta(struct Biblioteca *bib, const char *nombre, int isbn, int cantidad, char *respuesta, size_t tam) {
+    if (cantidad < 1 || cantidad > MAX_EJEMPLAR || isbn <= 0 || nombre[0] == '\0') {
+        snprintf(respuesta, tam, "Error: Alta inválida para ISBN %d (de 1 a %d ejemplares)", isbn, MAX_EJEMPLAR);
+        return 0;
+    }
+    //Los ejemplares nuevos quedan disponibles con la fecha de hoy
+    char fecha[11];
+    fechaDia(diaHoy(), fecha);
+    struct Catalogo *nuevo = calloc(1, sizeof(struct Catalogo));
+    if (!nuevo) {
+        snprintf(respuesta, tam, "Error: No hay memoria para el alta de ISBN %d", isbn);
+        return 0;
+    }
+    struct Aviso avisos[MAX_EJEMPLAR];
+    int numAvisos = 0;
+    int exito = 1;
+
+    pthread_mutex_lock(&bib->mutexCambios);
+    pthread_mutex_lock(&bib->mutexLibros);
+    struct Catalogo *cat = catalogoActual(bib);
+    int i = buscarIsbn(&cat->indiceIsbn, isbn);
+    if (i >= 0) {
+        struct Libros *libro = &cat->libros[i];
+        if (strcmp(libro->nombre, nombre) != 0) {
+            snprintf(respuesta, tam, "Error: ISBN %d ya existe con el nombre %s", isbn, libro->nombre);
+            exito = 0;
+        } else if (libro->numEj + cantidad > MAX_EJEMPLAR) {
+            snprintf(respuesta, tam, "Error: ISBN %d tendría más de %d ejemplares", isbn, MAX_EJEMPLAR);
+            exito = 0;
+        } else {
+            //Los números nuevos siguen al mayor que ya tiene el libro
+            int numero = 0;
+            for (int j = 0; j < libro->numEj; j++) {
+                if (libro->ejemplares[j].numero > numero) numero = libro->ejemplares[j].numero;
+            }
+            for (int k = 0; k < cantidad; k++) {
+                int j = libro->numEj;
+                libro->ejemplares[j].numero = ++numero;
+                libro->ejemplares[j].status = 'D';
+                libro->ejemplares[j].prestatario = 0;
+                memcpy(libro->ejemplares[j].fecha, fecha, sizeof(fecha));
+                libro->numEj++;
+                avisos[numAvisos].pid = 0;
+                asignarReserva(bib, i, j, &avisos[numAvisos]);
+                if (avisos[numAvisos].pid) numAvisos++;
+            }
+            marcarCambio(cat, i);
+            actualizarResumen(cat, i);
+            snprintf(respuesta, tam, "Alta en %s: ISBN %d, %d ejemplares nuevos (ahora %d), %d asignados a reservas",
+                     bib->id, isbn, cantidad, libro->numEj, numAvisos);
+        }
+        pthread_mutex_unlock(&bib->mutexLibros);
+        free(nuevo);
+    } else if (cat->numLibros == MAX_LIBROS) {
+        pthread_mutex_unlock(&bib->mutexLibros);
+        free(nuevo);
+        snprintf(respuesta, tam, "Error: El catálogo de %s ya tiene %d libros", bib->id, MAX_LIBROS);
+        exito = 0;
+    } else {
+        //Se copian los libros con el mutex y el resto se arma sin él; la fusión pasa el estado vigente
+        memcpy(nuevo->libros, cat->libros, sizeof(struct Libros) * cat->numLibros);
+        nuevo->numLibros = cat->numLibros;
+        pthread_mutex_unlock(&bib->mutexLibros);
+        struct Libros *libro = &nuevo->libros[nuevo->numLibros++];
+        libro->isbn = isbn;
+        snprintf(libro->nombre, sizeof(libro->nombre), "%s", nombre);
+        libro->numEj = cantidad;
+        for (int j = 0; j < cantidad; j++) {
+            libro->ejemplares[j].numero = j + 1;
+            libro->ejemplares[j].status = 'D';
+            libro->ejemplares[j].prestatario = 0;
+            memcpy(libro->ejemplares[j].fecha, fecha, sizeof(fecha));
+        }
+        publicarCatalogo(bib, nuevo);
+        snprintf(respuesta, tam, "Alta en %s: libro nuevo %s, ISBN %d, %d ejemplares", bib->id, nombre, isbn, cantidad);
+    }
+    //El cambio se guarda para que lo vean la próxima recarga y el próximo arranque, y la respuesta
+    //dice dónde quedó
+    if (exito) {
+        char destino[512];
+        size_t largo = strlen(respuesta);
+        if (!guardarBaseDatos(bib, destino, sizeof(destino))) {
+            snprintf(respuesta + largo, tam - largo, ". No se pudo guardar en %s", destino);
+        } else if (strcmp(destino, bib->archivo) != 0) {
+            snprintf(respuesta + largo, tam - largo, ". %s cambió desde la última carga y no se pisó: el catálogo se guardó en %s", bib->archivo, destino);
+        } else {
+            snprintf(respuesta + largo, tam - largo, ". Guardado en %s", destino);
+        }
+    }
+    pthread_mutex_unlock(&bib->mutexCambios);
+
+    for (int k = 0; k < numAvisos; k++) {
+        enviarAviso(avisos[k].pid, avisos[k].mensaje);
+    }
+    return exito;
+}
+
+// Escribe el catálogo vigente en el archivo de la base de datos con guardarSalida, primero en un
+// temporal que después reemplaza al original, así una recarga nunca lee un archivo a medio escribir.
+// Si el archivo cambió desde que el receptor lo leyó o lo escribió por última vez, alguien lo editó
+// y esos cambios todavía no están en el catálogo: no se pisa y el catálogo se escribe aparte, en
+// <archivo>.alta. Deja en destino el archivo que se escribió. Debe llamarse con mutexCambios tomado.
+// Devuelve 0 si no se pudo escribir
+int guardarBaseDatos(struct Biblioteca *bib, char *destino, size_t tam) {
+    struct timespec actual = modificacionArchivo(bib->archivo);
+    int editado = actual.tv_sec != bib->archivoLeido.tv_sec || actual.tv_nsec != bib->archivoLeido.tv_nsec;
+    if (editado) {
+        snprintf(destino, tam, "%s.alta", bib->archivo);
+        registrar(LOG_AVISO, "%s cambió desde la última carga, el alta se guarda en %s", bib->archivo, destino);
+    } else {
+        snprintf(destino, tam, "%s", bib->archivo);
+    }
+    struct Libros *copia = malloc(sizeof(struct Libros) * MAX_LIBROS);
+    if (!copia) {
+        registrar(LOG_ERROR, "No se pudo reservar memoria para guardar %s", destino);
+        return 0;
+    }
+    pthread_mutex_lock(&bib->mutexLibros);
+    struct Catalogo *cat = catalogoActual(bib);
+    int numLibros = cat->numLibros;
+    memcpy(copia, cat->libros, sizeof(struct Libros) * numLibros);
+    pthread_mutex_unlock(&bib->mutexLibros);
+
+    char temporal[520];
+    snprintf(temporal, sizeof(temporal), "%s.tmp", destino);
+    int exito = guardarSalida(temporal, copia, numLibros) && rename(temporal, destino) == 0;
+    if (!exito) {
+        registrar(LOG_ERROR, "No se pudo guardar la base de datos %s", destino);
+        unlink(temporal);
+    } else if (!editado) {
+        //Lo que quedó escrito es el catálogo vigente, así que cuenta como leído
+        bib->archivoLeido = modificacionArchivo(bib->archivo);
+    }
+    free(copia);
+    return exito;
+}
+
+// Extrae la siguiente orden del pipe de administración. Las órdenes terminan en '\n' o en '\0',
+// así se pueden mandar con echo o con las mismas tramas del solicitante. Devuelve el largo o -1
+static int siguienteOrden(int fd, char *orden, int tam) {
+    static char pendiente[MAX_ORDEN_ADMIN];
+    static int lenPendiente = 0;
+
+    while (1) {
+        for (int k = 0; k < lenPendiente; k++) {
+            if (pendiente[k] == '\n' || pendiente[k] == '\0') {
+                int copia = k < tam - 1 ? k : tam - 1;
+                memcpy(orden, pendiente, copia);
+                orden[copia] = '\0';
+                lenPendiente -= k + 1;
+                memmove(pendiente, pendiente + k + 1, lenPendiente);
+                return copia;
+            }
+        }
+        if (lenPendiente == (int)sizeof(pendiente)) {
+            registrar(LOG_AVISO, "Orden de administración demasiado larga descartada");
+            lenPendiente = 0;
+        }
+        int bytes = read(fd, pendiente + lenPendiente, sizeof(pendiente) - lenPendiente);
+        if (bytes < 0 && errno == EINTR) continue;
+        if (bytes <= 0) return -1;
+        lenPendiente += bytes;
+    }
+}
+
+// Aplica un alta que salió del carril de altas, deja el resultado en la bitácora y, si la orden
+// trajo p=pid, se lo responde al administrador por pipe_<pid>
+void altaProceso(struct Biblioteca *bib, struct Operaciones *op) {
+    char respuesta[1024];
+    int exito = aplicarAlta(bib, op->nombre, op->isbn, op->cantidad, respuesta, sizeof(respuesta));
+    registrar(exito ? LOG_INFO : LOG_AVISO, "%s", respuesta);
+    registrarOperacion('A', exito, op->tIngreso);
+    if (op->pid > 0) {
+        enviarRespuesta(op->pid, respuesta);
+    }
+}
+
+// Pid del campo opcional p=pid de una orden, al que se le responde, o 0 si no lo trae. El nombre no
+// puede tener comas, así que un campo que empieza con "p=" después de una coma solo puede ser ese
+static int pidDeOrden(const char *orden) {
+    for (const char *campo = strchr(orden, ','); campo; campo = strchr(campo + 1, ',')) {
+        const char *valor = campo + 1 + strspn(campo + 1, " ");
+        if (strncmp(valor, "p=", 2) == 0) return atoi(valor + 2);
+    }
+    return 0;
+}
+
+// Hilo que atiende el pipe de administración. Cada alta va al carril de altas de su biblioteca,
+// donde se aplican de a una y en el orden en que llegaron
+void *administrador(void *args) {
+    int fd = *(int *)args;
+    char orden[MAX_ORDEN_ADMIN];
+    while (siguienteOrden(fd, orden, sizeof(orden)) >= 0 && !terminar) {
+        //Las líneas vacías (y la que manda el hilo principal para despertarlo) se ignoran
+        if (orden[0] == '\0') continue;
+        struct Operaciones op = {0};
+        op.tIngreso = tiempoNs();
+        op.pid = pidDeOrden(orden);
+        char error[MAX_ORDEN_ADMIN + 64];
+        if (sscanf(orden, "%c, %249[^,],%d,%d", &op.tipo, op.nombre, &op.isbn, &op.cantidad) != 4 || op.tipo != 'A') {
+            snprintf(error, sizeof(error), "Error: Orden de administración inválida: %s", orden);
+            registrar(LOG_AVISO, "%s", error);
+            if (op.pid > 0) enviarRespuesta(op.pid, error);
+            continue;
+        }
+        leerCamposOpcionales(orden, 4, &op);
+        if (op.biblioteca < 0) {
+            snprintf(error, sizeof(error), "Error: Biblioteca no encontrada para el alta de ISBN %d", op.isbn);
+            registrar(LOG_AVISO, "%s", error);
+            registrarOperacion('A', 0, op.tIngreso);
+            if (op.pid > 0) enviarRespuesta(op.pid, error);
+            continue;
+        }
+        anadirBuffer(&bibliotecas[op.biblioteca], &op);
+    }
+    return NULL;
+}
+
+// Despierta al hilo de administración para que vea terminar. El receptor tiene el pipe abierto en
+// lectura/escritura, así que puede escribirse a sí mismo una orden vacía
+void despertarAdministrador(int fd) {
+    if (write(fd, "\n", 1) == -1) {
+        registrar(LOG_ERROR, "No se pudo despertar al hilo de administración");
+    }
+}
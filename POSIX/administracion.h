@@ -0,0 +1,32 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: administracion.h
+#	Descripcion: Archivo de encabezado para administracion.c.
+#                Define el pipe de administración del receptor y la operación A, que agrega libros
+#                o ejemplares al catálogo mientras se atienden préstamos, devoluciones y renovaciones
+#****************************************************************/
+
+#ifndef ADMINISTRACION_H
+#define ADMINISTRACION_H
+
+#include <stddef.h>
+
+// Largo máximo de una orden "A,nombre,isbn,cantidad[,b=id][,p=pid]"
+#define MAX_ORDEN_ADMIN 512
+
+struct Biblioteca;
+struct Operaciones;
+
+// Funciones de administración
+int abrirPipeAdmin(const char *nombre);
+int aplicarAlta(struct Biblioteca *bib, const char *nombre, int isbn, int cantidad, char *respuesta, size_t tam);
+int guardarBaseDatos(struct Biblioteca *bib, char *destino, size_t tam);
+void altaProceso(struct Biblioteca *bib, struct Operaciones *op);
+void *administrador(void *args);
+void despertarAdministrador(int fd);
+
+#endif
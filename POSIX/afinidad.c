@@ -0,0 +1,113 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: afinidad.c
+#	Descripcion: Topología de hilos del receptor. Con -C cada rol (ingreso, trabajo, escritura y
+#                consola) se fija a las CPUs que se indiquen con pthread_setaffinity_np, así el
+#                hilo que lee el pipe y los que atienden el buffer no se mueven de núcleo y sus
+#                líneas de caché no rebotan entre todas las CPUs. Sin -C el kernel los reparte.
+#****************************************************************/
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include "afinidad.h"
+#include "bitacora.h"
+
+static const char *nombresRoles[NUM_ROLES] = {"ingreso", "trabajo", "escritura", "consola"};
+static struct RolCpus roles[NUM_ROLES];
+static struct HiloFijado hilos[MAX_HILOS_TOPOLOGIA];
+static int numHilos = 0;
+static int activa = 0;
+
+// Agrega a rol las CPUs de una lista "0,2-3". Devuelve 0 si la lista es inválida o nombra una CPU
+// que no existe
+static int leerCpus(const char *lista, int largo, struct RolCpus *rol) {
+    long numCpus = sysconf(_SC_NPROCESSORS_CONF);
+    const char *fin = lista + largo;
+    while (lista < fin) {
+        char *resto;
+        long desde = strtol(lista, &resto, 10);
+        long hasta = desde;
+        if (resto == lista) return 0;
+        if (*resto == '-') {
+            lista = resto + 1;
+            hasta = strtol(lista, &resto, 10);
+            if (resto == lista) return 0;
+        }
+        if (desde < 0 || hasta < desde || hasta >= numCpus || hasta >= CPU_SETSIZE || resto > fin) return 0;
+        for (long cpu = desde; cpu <= hasta; cpu++) {
+            if (rol->num == MAX_CPUS_ROL) return 0;
+            rol->cpus[rol->num++] = cpu;
+        }
+        if (resto < fin && *resto != ',') return 0;
+        lista = resto + 1;
+    }
+    return rol->num > 0;
+}
+
+// Lee la topología "rol=cpus[:rol=cpus...]", por ejemplo "ingreso=0:trabajo=1-2:escritura=3".
+// Los roles que no aparecen quedan sin fijar. Devuelve 0 si el texto es inválido
+int leerTopologia(const char *texto) {
+    memset(roles, 0, sizeof(roles));
+    while (*texto) {
+        const char *igual = strchr(texto, '=');
+        if (!igual) return 0;
+        const char *fin = strchr(igual, ':');
+        if (!fin) fin = igual + strlen(igual);
+        int rol = -1;
+        for (int r = 0; r < NUM_ROLES; r++) {
+            if ((int)strlen(nombresRoles[r]) == igual - texto && strncmp(texto, nombresRoles[r], igual - texto) == 0) rol = r;
+        }
+        if (rol < 0 || roles[rol].num > 0 || !leerCpus(igual + 1, fin - igual - 1, &roles[rol])) return 0;
+        texto = *fin ? fin + 1 : fin;
+    }
+    activa = 1;
+    return 1;
+}
+
+// Fija el hilo a la siguiente CPU de su rol y lo anota para el reporte. Solo se llama desde el hilo
+// principal mientras arranca el receptor. El hilo principal debe fijarse al final, porque los hilos
+// que crea después heredan su afinidad
+void fijarHilo(int rol, pthread_t hilo, const char *nombre) {
+    if (!activa) return;
+    int cpu = -1;
+    struct RolCpus *r = &roles[rol];
+    if (r->num > 0) {
+        cpu = r->cpus[r->siguiente];
+        r->siguiente = (r->siguiente + 1) % r->num;
+        cpu_set_t conjunto;
+        CPU_ZERO(&conjunto);
+        CPU_SET(cpu, &conjunto);
+        int error = pthread_setaffinity_np(hilo, sizeof(conjunto), &conjunto);
+        if (error != 0) {
+            registrar(LOG_AVISO, "No se pudo fijar %s a la CPU %d: %s", nombre, cpu, strerror(error));
+            cpu = -1;
+        }
+    }
+    if (numHilos < MAX_HILOS_TOPOLOGIA) {
+        snprintf(hilos[numHilos].nombre, sizeof(hilos[numHilos].nombre), "%s", nombre);
+        hilos[numHilos].rol = rol;
+        hilos[numHilos].cpu = cpu;
+        numHilos++;
+    }
+}
+
+// Deja en la bitácora la topología elegida: cada hilo con su rol y su CPU
+void imprimirTopologia(void) {
+    if (!activa) return;
+    registrar(LOG_INFO, "Topología de hilos (%ld CPUs en línea):", sysconf(_SC_NPROCESSORS_ONLN));
+    for (int k = 0; k < numHilos; k++) {
+        if (hilos[k].cpu < 0) {
+            registrar(LOG_INFO, "  %-20s %-10s sin fijar", hilos[k].nombre, nombresRoles[hilos[k].rol]);
+        } else {
+            registrar(LOG_INFO, "  %-20s %-10s CPU %d", hilos[k].nombre, nombresRoles[hilos[k].rol], hilos[k].cpu);
+        }
+    }
+}
@@ -0,0 +1,46 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: afinidad.h
+#	Descripcion: Archivo de encabezado para afinidad.c.
+#                Define los roles de los hilos del receptor y las CPUs a las que se fija cada uno
+#****************************************************************/
+
+#ifndef AFINIDAD_H
+#define AFINIDAD_H
+
+#include <pthread.h>
+
+// Roles que se pueden fijar con -C (o --cpus)
+#define ROL_INGRESO 0 // Hilo principal, lector de tramas y administración
+#define ROL_TRABAJO 1 // Hilos auxiliar1 de cada biblioteca
+#define ROL_ESCRITURA 2 // Escritores de respuestas
+#define ROL_CONSOLA 3 // Consola (auxiliar2), recarga, métricas y recordatorios
+#define NUM_ROLES 4
+#define MAX_CPUS_ROL 64
+#define MAX_HILOS_TOPOLOGIA 64
+
+// CPUs de un rol. Los hilos del rol las toman en orden, uno por CPU, y vuelven a empezar si hay más
+// hilos que CPUs
+struct RolCpus {
+    int cpus[MAX_CPUS_ROL];
+    int num; // 0 si el rol no se fija
+    int siguiente;
+};
+
+// Un hilo que ya pasó por fijarHilo, para el reporte de la topología
+struct HiloFijado {
+    char nombre[32];
+    int rol;
+    int cpu; // -1 si quedó sin fijar
+};
+
+// Funciones de la topología de hilos
+int leerTopologia(const char *texto);
+void fijarHilo(int rol, pthread_t hilo, const char *nombre);
+void imprimirTopologia(void);
+
+#endif
@@ -0,0 +1,143 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: biblioteca.c
+#	Descripcion: Manejo de las bibliotecas del receptor. Cada opción -f agrega una biblioteca con
+#                su propio catálogo, buffer, mutex, índices e hilos; aquí se cargan, se buscan por
+#                nombre y se decide el archivo de salida de cada una.
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "biblioteca.h"
+#include "bitacora.h"
+
+// Arreglo de bibliotecas, se reserva con la primera opción -f
+struct Biblioteca *bibliotecas = NULL;
+int numBibliotecas = 0;
+
+// Agrega una biblioteca a partir de la opción -f, que puede ser "id=archivo" o solo "archivo"
+// (en ese caso se llama BIBLIOTECA_DEFECTO). Devuelve 0 si hay demasiadas o el nombre se repite
+int agregarBiblioteca(char *opcion) {
+    if (!bibliotecas) {
+        bibliotecas = calloc(MAX_BIBLIOTECAS, sizeof(struct Biblioteca));
+        if (!bibliotecas) return 0;
+    }
+    if (numBibliotecas == MAX_BIBLIOTECAS) {
+        printf("Error: Máximo %d bibliotecas\n", MAX_BIBLIOTECAS);
+        return 0;
+    }
+    struct Biblioteca *bib = &bibliotecas[numBibliotecas];
+    char *igual = strchr(opcion, '=');
+    if (igual) {
+        int largo = igual - opcion;
+        if (largo == 0 || largo >= LARGO_ID_BIBLIOTECA || memchr(opcion, ',', largo) != NULL) {
+            printf("Error: Nombre de biblioteca inválido en %s\n", opcion);
+            return 0;
+        }
+        memcpy(bib->id, opcion, largo);
+        bib->id[largo] = '\0';
+        bib->archivo = igual + 1;
+    } else {
+        snprintf(bib->id, sizeof(bib->id), "%s", BIBLIOTECA_DEFECTO);
+        bib->archivo = opcion;
+    }
+    if (buscarBiblioteca(bib->id, strlen(bib->id)) >= 0) {
+        printf("Error: La biblioteca %s está repetida\n", bib->id);
+        return 0;
+    }
+    numBibliotecas++;
+    return 1;
+}
+
+// Carga el catálogo de la biblioteca, arma sus índices e inicializa su sincronización y su buffer
+// con un carril de la capacidad dada por cada clase de operación, cada uno con su peso (marca 0 si se
+// espera a que haya espacio en lugar de rechazar). Devuelve 0 si la base de datos no se pudo leer
+int iniciarBiblioteca(struct Biblioteca *bib, int capacidad, int marca, const int *pesos) {
+    struct timespec leido = modificacionArchivo(bib->archivo);
+    struct Catalogo *cat = crearCatalogo(bib->archivo);
+    if (!cat) {
+        return 0;
+    }
+    bib->archivoLeido = leido;
+    for (int c = 0; c < NUM_CARRILES; c++) {
+        bib->carriles[c].ops = malloc(sizeof(struct Operaciones) * capacidad);
+        if (!bib->carriles[c].ops) {
+            while (c-- > 0) free(bib->carriles[c].ops);
+            liberarCatalogo(cat);
+            return 0;
+        }
+        bib->carriles[c].inicio = 0;
+        bib->carriles[c].cont = 0;
+        bib->carriles[c].peso = pesos[c];
+        bib->carriles[c].credito = 0;
+    }
+    bib->bufferTam = capacidad;
+    bib->marcaAlta = marca;
+    bib->adminEnCurso = 0;
+    atomic_init(&bib->servicioUs, 0);
+    prepararCatalogo(cat);
+    atomic_init(&bib->catalogo, cat);
+
+    bib->bufferCont = 0;
+    pthread_mutex_init(&bib->mutex, NULL);
+    pthread_mutex_init(&bib->mutexLibros, NULL);
+    pthread_mutex_init(&bib->mutexCambios, NULL);
+    pthread_cond_init(&bib->cond_no_lleno, NULL);
+    pthread_cond_init(&bib->cond_no_vacio, NULL);
+    return 1;
+}
+
+// Catálogo vigente de la biblioteca. Solo se puede usar mientras se tenga mutexLibros, porque
+// una recarga lo cambia con el mutex tomado; sin el mutex hay que usar leerCatalogo
+struct Catalogo *catalogoActual(struct Biblioteca *bib) {
+    return atomic_load_explicit(&bib->catalogo, memory_order_acquire);
+}
+
+// Devuelve la posición de la biblioteca con ese nombre (los primeros largo caracteres de id) o -1
+int buscarBiblioteca(const char *id, size_t largo) {
+    for (int b = 0; b < numBibliotecas; b++) {
+        if (strlen(bibliotecas[b].id) == largo && strncmp(bibliotecas[b].id, id, largo) == 0) {
+            return b;
+        }
+    }
+    return -1;
+}
+
+// Nombre del archivo de salida de una biblioteca. Con una sola biblioteca es el de -s tal cual;
+// con varias se agrega "_id" antes de la extensión para que cada una quede en su propio archivo
+void nombreSalida(const char *fileSalida, const struct Biblioteca *bib, char *nombre, size_t tam) {
+    if (numBibliotecas == 1) {
+        snprintf(nombre, tam, "%s", fileSalida);
+        return;
+    }
+    const char *punto = strrchr(fileSalida, '.');
+    const char *barra = strrchr(fileSalida, '/');
+    if (!punto || (barra && punto < barra)) {
+        snprintf(nombre, tam, "%s_%s", fileSalida, bib->id);
+        return;
+    }
+    snprintf(nombre, tam, "%.*s_%s%s", (int)(punto - fileSalida), fileSalida, bib->id, punto);
+}
+
+// Libera los catálogos y la sincronización de todas las bibliotecas
+void liberarBibliotecas(void) {
+    for (int b = 0; b < numBibliotecas; b++) {
+        liberarCatalogo(atomic_load(&bibliotecas[b].catalogo));
+        for (int c = 0; c < NUM_CARRILES; c++) {
+            free(bibliotecas[b].carriles[c].ops);
+        }
+        pthread_mutex_destroy(&bibliotecas[b].mutex);
+        pthread_mutex_destroy(&bibliotecas[b].mutexLibros);
+        pthread_mutex_destroy(&bibliotecas[b].mutexCambios);
+        pthread_cond_destroy(&bibliotecas[b].cond_no_lleno);
+        pthread_cond_destroy(&bibliotecas[b].cond_no_vacio);
+    }
+    free(bibliotecas);
+    bibliotecas = NULL;
+    numBibliotecas = 0;
+}
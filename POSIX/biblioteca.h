@@ -0,0 +1,99 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: biblioteca.h
+#	Descripcion: Archivo de encabezado para biblioteca.c.
+#                Define la partición del receptor por biblioteca (catálogo, buffer, mutex, índices e hilos
+#                propios) y los prototipos de las funciones que trabajan sobre una biblioteca
+#****************************************************************/
+
+#ifndef BIBLIOTECA_H
+#define BIBLIOTECA_H
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include "receptor.h"
+#include "catalogo.h"
+
+#define MAX_BIBLIOTECAS 8
+#define MAX_HILOS_BIBLIOTECA 4
+#define LARGO_ID_BIBLIOTECA 32
+// Sin "id=" en -f la biblioteca se llama BIBLIOTECA_DEFECTO (protocolo.h)
+
+// Cola FIFO de un carril del buffer con su peso en el reparto ponderado
+struct Carril {
+    struct Operaciones *ops;
+    int inicio;
+    int cont;
+    int peso;
+    int credito; // Crédito acumulado del reparto; se elige el carril con más
+};
+
+// Una biblioteca con su catálogo y todo lo que lo protege o lo indexa. Nada de esto se comparte
+// entre bibliotecas, así la carga de una no espera los mutex ni el buffer de otra
+struct Biblioteca {
+    char id[LARGO_ID_BIBLIOTECA];
+    char *archivo;
+    // Modificación del archivo la última vez que se leyó o que el receptor lo escribió. Un alta no
+    // lo pisa si cambió desde entonces (alguien lo editó y todavía no se recargó)
+    struct timespec archivoLeido;
+    // Catálogo vigente; una recarga lo reemplaza completo con mutexLibros tomado
+    _Atomic(struct Catalogo *) catalogo;
+    // Buffer con un carril por clase de operación, su mutex y variables de condición. Con
+    // marcaAlta > 0 el hilo principal no espera a que haya espacio para un P, D o R: al llegar su
+    // carril a la marca responde que está ocupado. bufferCont es el total en los carriles y
+    // adminEnCurso vale 1 mientras un hilo aplica un alta, para que no corran dos a la vez
+    struct Carril carriles[NUM_CARRILES];
+    int bufferTam;
+    int bufferCont;
+    int marcaAlta;
+    int adminEnCurso;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond_no_lleno;
+    pthread_cond_t cond_no_vacio;
+    // Protege el catálogo, las listas de espera, los vencimientos y la tabla de préstamos
+    pthread_mutex_t mutexLibros;
+    // Serializa los cambios de libros y ejemplares (recargas y altas de administración) y la
+    // escritura del archivo de la base de datos. P, D, R, B y C nunca lo toman
+    pthread_mutex_t mutexCambios;
+    // Hilos auxiliar1 que atienden los carriles de esta biblioteca y su tiempo medio por operación (us),
+    // que se usa para sugerir cuánto esperar al responder que está ocupado
+    pthread_t hilos[MAX_HILOS_BIBLIOTECA];
+    int numHilos;
+    atomic_long servicioUs;
+};
+
+// Bibliotecas cargadas, en el orden de las opciones -f. La primera es la que se usa si la
+// operación no trae el campo b=
+extern struct Biblioteca *bibliotecas;
+extern int numBibliotecas;
+
+// Funciones de las bibliotecas (biblioteca.c)
+int agregarBiblioteca(char *opcion);
+int iniciarBiblioteca(struct Biblioteca *bib, int capacidad, int marca, const int *pesos);
+struct Catalogo *catalogoActual(struct Biblioteca *bib);
+void nombreSalida(const char *fileSalida, const struct Biblioteca *bib, char *nombre, size_t tam);
+void liberarBibliotecas(void);
+
+// Funciones del receptor que trabajan sobre una biblioteca (receptor.c)
+int anadirBuffer(struct Biblioteca *bib, struct Operaciones *op);
+void rechazarOcupado(struct Biblioteca *bib, struct Operaciones *op);
+struct Operaciones leerBuffer(struct Biblioteca *bib);
+int aplicarDevolucion(struct Biblioteca *bib, struct Operaciones *op, char *respuesta, struct Aviso *aviso);
+int aplicarPrestamo(struct Biblioteca *bib, struct Operaciones *op, char *respuesta);
+void actualizarResumen(struct Catalogo *cat, int i);
+int encolarReserva(struct Biblioteca *bib, struct Operaciones *op, int i, char *respuesta);
+void asignarReserva(struct Biblioteca *bib, int i, int j, struct Aviso *aviso);
+void cancelarReservas(struct Biblioteca *bib);
+int aplicarConsulta(struct Catalogo *cat, struct Operaciones *op, char *respuesta);
+void imprimirVencidos(struct Biblioteca *bib);
+void prestamoProceso(struct Biblioteca *bib, struct Operaciones *op);
+void procesarLote(struct Biblioteca *bib, struct Lote *lote);
+void busquedaProceso(struct Biblioteca *bib, struct Operaciones *op);
+void consultaProceso(struct Biblioteca *bib, struct Operaciones *op);
+void listarProceso(struct Biblioteca *bib, struct Operaciones *op);
+
+#endif
@@ -0,0 +1,157 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: bitacora.c
+#	Descripcion: Bitácora asíncrona del receptor. Cada hilo formatea sus mensajes en su propio anillo
+#                sin locks y un hilo escritor los vacía hacia la salida, así imprimir nunca bloquea
+#                el procesamiento de operaciones. Si un anillo se llena el mensaje se descarta y se cuenta.
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "bitacora.h"
+
+// Anillos registrados, uno por hilo que haya escrito en la bitácora
+static struct AnilloLog *_Atomic anillos[MAX_ANILLOS];
+static atomic_int numAnillos = 0;
+static __thread struct AnilloLog *anilloLocal = NULL;
+
+// Estado del escritor
+static FILE *salidaLog = NULL;
+static int nivelLog = LOG_INFO;
+static atomic_int activa = 0;
+static atomic_int detener = 0;
+static pthread_t hiloEscritor;
+
+atomic_ulong logDescartados = 0;
+
+static const char *nombresNivel[] = {"DEBUG", "INFO", "AVISO", "ERROR"};
+
+// Devuelve el anillo del hilo actual, creándolo la primera vez. NULL si ya no hay espacios
+static struct AnilloLog *anilloDelHilo(void) {
+    if (!anilloLocal) {
+        int slot = atomic_fetch_add(&numAnillos, 1);
+        if (slot >= MAX_ANILLOS) {
+            return NULL;
+        }
+        struct AnilloLog *anillo = calloc(1, sizeof(struct AnilloLog));
+        if (!anillo) {
+            return NULL;
+        }
+        atomic_store(&anillos[slot], anillo);
+        anilloLocal = anillo;
+    }
+    return anilloLocal;
+}
+
+// Escribe una entrada con su marca de tiempo y nivel
+static void escribirEntrada(struct EntradaLog *e) {
+    time_t seg = e->tiempo / 1000000000LL;
+    struct tm fecha;
+    localtime_r(&seg, &fecha);
+    char marca[32];
+    strftime(marca, sizeof(marca), "%Y-%m-%d %H:%M:%S", &fecha);
+    fprintf(salidaLog, "%s.%03lld [%s] %s\n", marca, (e->tiempo / 1000000LL) % 1000, nombresNivel[e->nivel], e->texto);
+}
+
+// Vacía todos los anillos; devuelve cuántas entradas escribió
+static int vaciarAnillos(void) {
+    int escritas = 0;
+    int total = atomic_load(&numAnillos);
+    if (total > MAX_ANILLOS) total = MAX_ANILLOS;
+    for (int i = 0; i < total; i++) {
+        struct AnilloLog *anillo = atomic_load(&anillos[i]);
+        if (!anillo) continue;
+        unsigned long cola = atomic_load_explicit(&anillo->cola, memory_order_relaxed);
+        unsigned long cabeza = atomic_load_explicit(&anillo->cabeza, memory_order_acquire);
+        while (cola != cabeza) {
+            escribirEntrada(&anillo->entradas[cola % TAM_ANILLO]);
+            cola++;
+            escritas++;
+        }
+        atomic_store_explicit(&anillo->cola, cola, memory_order_release);
+    }
+    if (escritas > 0) {
+        fflush(salidaLog);
+    }
+    return escritas;
+}
+
+// Hilo escritor: vacía los anillos y duerme un poco cuando no hay nada que escribir
+static void *escritorBitacora(void *args) {
+    (void)args;
+    while (!atomic_load(&detener)) {
+        if (vaciarAnillos() == 0) {
+            usleep(1000);
+        }
+    }
+    vaciarAnillos();
+    return NULL;
+}
+
+// Inicia el hilo escritor. Los mensajes con nivel menor a nivelMinimo se ignoran
+void iniciarBitacora(FILE *salida, int nivelMinimo) {
+    salidaLog = salida;
+    nivelLog = nivelMinimo;
+    atomic_store(&detener, 0);
+    if (pthread_create(&hiloEscritor, NULL, escritorBitacora, NULL) == 0) {
+        atomic_store(&activa, 1);
+    }
+}
+
+// Registra un mensaje. Se formatea en el anillo del hilo y nunca espera al escritor
+void registrar(int nivel, const char *formato, ...) {
+    if (nivel < nivelLog) return;
+    va_list args;
+    va_start(args, formato);
+
+    // Sin escritor (antes de iniciar o después de detener) se imprime directamente
+    if (!atomic_load_explicit(&activa, memory_order_acquire)) {
+        vprintf(formato, args);
+        printf("\n");
+        va_end(args);
+        return;
+    }
+
+    struct AnilloLog *anillo = anilloDelHilo();
+    if (!anillo) {
+        atomic_fetch_add_explicit(&logDescartados, 1, memory_order_relaxed);
+        va_end(args);
+        return;
+    }
+    unsigned long cabeza = atomic_load_explicit(&anillo->cabeza, memory_order_relaxed);
+    unsigned long cola = atomic_load_explicit(&anillo->cola, memory_order_acquire);
+    if (cabeza - cola >= TAM_ANILLO) {
+        atomic_fetch_add_explicit(&logDescartados, 1, memory_order_relaxed);
+        va_end(args);
+        return;
+    }
+    struct EntradaLog *e = &anillo->entradas[cabeza % TAM_ANILLO];
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    e->tiempo = (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    e->nivel = nivel;
+    vsnprintf(e->texto, sizeof(e->texto), formato, args);
+    va_end(args);
+    atomic_store_explicit(&anillo->cabeza, cabeza + 1, memory_order_release);
+}
+
+// Detiene el escritor después de vaciar lo pendiente e informa los descartes
+void detenerBitacora(void) {
+    if (!atomic_load(&activa)) return;
+    atomic_store(&detener, 1);
+    pthread_join(hiloEscritor, NULL);
+    atomic_store(&activa, 0);
+    unsigned long descartados = atomic_load(&logDescartados);
+    if (descartados > 0) {
+        printf("Bitácora: %lu mensajes descartados por anillo lleno\n", descartados);
+    }
+}
@@ -0,0 +1,54 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: bitacora.h
+#	Descripcion: Archivo de encabezado para bitacora.c.
+#                Define los niveles y los anillos por hilo de la bitácora asíncrona del receptor
+#****************************************************************/
+
+#ifndef BITACORA_H
+#define BITACORA_H
+
+#include <stdio.h>
+#include <stdatomic.h>
+
+#define MAX_ANILLOS 64
+// Entradas por anillo (potencia de 2) y largo máximo de cada mensaje
+#define TAM_ANILLO 1024
+#define LARGO_LOG 160
+
+// Niveles de la bitácora, de menor a mayor severidad
+enum NivelLog {
+    LOG_DEBUG,
+    LOG_INFO,
+    LOG_AVISO,
+    LOG_ERROR
+};
+
+// Mensaje ya formateado, con su instante (ns de reloj real) y nivel
+struct EntradaLog {
+    long long tiempo;
+    int nivel;
+    char texto[LARGO_LOG];
+};
+
+// Anillo de un solo productor (el hilo dueño) y un solo consumidor (el escritor).
+// cabeza solo la mueve el productor y cola solo el escritor, por eso no se necesita lock
+struct AnilloLog {
+    atomic_ulong cabeza;
+    atomic_ulong cola;
+    struct EntradaLog entradas[TAM_ANILLO];
+};
+
+// Mensajes descartados porque el anillo del hilo estaba lleno
+extern atomic_ulong logDescartados;
+
+// Funciones de la bitácora
+void iniciarBitacora(FILE *salida, int nivelMinimo);
+void registrar(int nivel, const char *formato, ...) __attribute__((format(printf, 2, 3)));
+void detenerBitacora(void);
+
+#endif
@@ -0,0 +1,324 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: catalogo.c
+#	Descripcion: Carga y recarga del catálogo de cada biblioteca. La recarga (SIGHUP o el comando c)
+#                lee el archivo en un hilo aparte, le pasa el estado de los préstamos del catálogo
+#                vigente y lo publica cambiando el puntero. El catálogo viejo se libera cuando todos
+#                los lectores sin mutex pasaron a una época posterior al cambio.
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sched.h>
+#include <sys/stat.h>
+#include "biblioteca.h"
+#include "bitacora.h"
+
+// Época global y la época de la lectura que ocupa cada casilla (0 si está libre)
+static atomic_ulong epocaGlobal = 1;
+static atomic_ulong epocaLectores[MAX_LECTORES_CATALOGO];
+static atomic_int numLectores = 0;
+// Casilla de la lectura en curso del hilo y la casilla por la que empieza a buscar
+static __thread int lectorLocal = -1;
+static __thread int casillaPreferida = -1;
+
+// Devuelve la fecha de modificación del archivo (ceros si no se puede consultar). Se toma antes de
+// leerlo, así una edición que llegue durante la lectura se nota como un cambio
+struct timespec modificacionArchivo(const char *archivo) {
+    struct stat info;
+    struct timespec cero = {0, 0};
+    return stat(archivo, &info) == 0 ? info.st_mtim : cero;
+}
+
+// Reserva un catálogo y lo llena con la base de datos. Devuelve NULL si no se pudo leer
+struct Catalogo *crearCatalogo(const char *archivo) {
+    struct Catalogo *cat = calloc(1, sizeof(struct Catalogo));
+    if (!cat) return NULL;
+    cat->numLibros = leerDB((char *)archivo, cat->libros);
+    if (cat->numLibros <= 0 || cat->numLibros > MAX_LIBROS) {
+        free(cat);
+        return NULL;
+    }
+    return cat;
+}
+
+// Arma los índices, el montículo de vencimientos y el resumen de un catálogo recién leído,
+// con los préstamos que ya venían en la base de datos sin solicitante registrado
+void prepararCatalogo(struct Catalogo *cat) {
+    //Se construye el índice de títulos para las búsquedas
+    if (!construirIndice(&cat->indiceTitulos, cat->libros, cat->numLibros)) {
+        registrar(LOG_ERROR, "No se pudo construir el índice de títulos, las búsquedas no tendrán resultados");
+    }
+    //Se arma la tabla de ISBN y el resumen inicial de cada libro para las consultas
+    construirIndiceIsbn(&cat->indiceIsbn, cat->libros, cat->numLibros);
+    //También se cargan al montículo las fechas de entrega de los ejemplares que ya estaban prestados
+    iniciarVencimientos(&cat->vencimientos);
+    iniciarPrestatarios(&cat->prestatarios);
+    for (int i = 0; i < cat->numLibros; i++) {
+        for (int j = 0; j < cat->libros[i].numEj; j++) {
+            if (cat->libros[i].ejemplares[j].status == 'P') {
+                programarVencimiento(&cat->vencimientos, i, j, diaFecha(cat->libros[i].ejemplares[j].fecha));
+            }
+        }
+        actualizarResumen(cat, i);
+    }
+}
+
+// Lo que la recarga necesita para pasar el estado de cada libro del catálogo viejo al nuevo
+struct Fusion {
+    struct Libros archivo[MAX_LIBROS]; // Libros del nuevo tal como se leyeron, para rehacer uno
+    int numArchivo;
+    int libroNuevo[MAX_LIBROS]; // Posición en el nuevo de cada libro del viejo, -1 si no pasa
+    unsigned version[MAX_LIBROS]; // versionLibro de cada libro del viejo cuando se pasó
+};
+
+// Anota que el libro i cambió, para que una recarga en curso lo vuelva a pasar al catálogo nuevo.
+// Debe llamarse con mutexLibros tomado
+void marcarCambio(struct Catalogo *cat, int i) {
+    cat->versionLibro[i]++;
+}
+
+// Pasa al catálogo nuevo el estado vivo del libro o del viejo: estado, fecha y prestatario de cada
+// ejemplar que sigue en el archivo, avisos de vencimiento ya dados y lista de espera. Un ejemplar
+// prestado que ya no está en el archivo se agrega igual, y un libro que desapareció se agrega
+// completo si tiene préstamos o reservas, así una recarga nunca pierde un préstamo. Si el libro ya
+// se había pasado, primero deshace lo que dejó esa vez. Debe llamarse con mutexLibros tomado.
+// Devuelve 1 si agregó el libro al final del nuevo
+static int fusionarLibro(struct Catalogo *nuevo, const struct Catalogo *viejo, struct Fusion *f, int o) {
+    const struct Libros *anterior = &viejo->libros[o];
+    f->version[o] = viejo->versionLibro[o];
+    int n = f->libroNuevo[o], agregado = 0;
+    if (n >= 0) {
+        //Se quitan los préstamos y vencimientos de la vez anterior y se vuelve a lo del archivo
+        for (int k = 0; k < nuevo->libros[n].numEj; k++) {
+            quitarPrestamo(&nuevo->prestatarios, n, k);
+            quitarVencimiento(&nuevo->vencimientos, n, k);
+        }
+        if (n < f->numArchivo) {
+            nuevo->libros[n] = f->archivo[n];
+        } else {
+            nuevo->libros[n].numEj = 0;
+        }
+    } else {
+        n = buscarIsbn(&nuevo->indiceIsbn, anterior->isbn);
+        if (n < 0) {
+            int ocupado = viejo->esperas[o].cont > 0;
+            for (int j = 0; j < anterior->numEj; j++) {
+                ocupado |= anterior->ejemplares[j].status == 'P';
+            }
+            if (!ocupado) return 0;
+            if (nuevo->numLibros == MAX_LIBROS) {
+                registrar(LOG_ERROR, "Recarga: no cabe el libro ISBN %d, que tiene préstamos", anterior->isbn);
+                return 0;
+            }
+            //El libro sale del archivo pero tiene préstamos, se conserva con sus ejemplares prestados
+            n = nuevo->numLibros++;
+            nuevo->libros[n] = *anterior;
+            nuevo->libros[n].numEj = 0;
+            agregado = 1;
+        } else {
+            //Los préstamos que el archivo trae para este libro los reemplaza el estado vivo
+            for (int k = 0; k < nuevo->libros[n].numEj; k++) {
+                quitarVencimiento(&nuevo->vencimientos, n, k);
+            }
+        }
+        f->libroNuevo[o] = n;
+    }
+
+    struct Libros *libro = &nuevo->libros[n];
+    int ejemplarNuevo[MAX_EJEMPLAR];
+    for (int j = 0; j < anterior->numEj; j++) {
+        const struct Ejemplar *ej = &anterior->ejemplares[j];
+        int k = 0;
+        while (k < libro->numEj && libro->ejemplares[k].numero != ej->numero) k++;
+        ejemplarNuevo[j] = -1;
+        if (k == libro->numEj) {
+            //Un ejemplar disponible que se quitó del archivo se deja de prestar
+            if (ej->status != 'P' || libro->numEj == MAX_EJEMPLAR) {
+                if (ej->status == 'P') {
+                    registrar(LOG_ERROR, "Recarga: no cabe el ejemplar %d prestado de ISBN %d", ej->numero, anterior->isbn);
+                }
+                continue;
+            }
+            libro->numEj++;
+            libro->ejemplares[k].numero = ej->numero;
+        }
+        libro->ejemplares[k].status = ej->status;
+        libro->ejemplares[k].prestatario = ej->prestatario;
+        memcpy(libro->ejemplares[k].fecha, ej->fecha, sizeof(ej->fecha));
+        if (ej->status == 'P' && ej->prestatario) {
+            registrarPrestamo(&nuevo->prestatarios, ej->prestatario, libro->isbn, n, k);
+        }
+        ejemplarNuevo[j] = k;
+    }
+    //Fechas de entrega, manteniendo los avisos de vencimiento que ya se dieron
+    for (int k = 0; k < libro->numEj; k++) {
+        if (libro->ejemplares[k].status == 'P') {
+            programarVencimiento(&nuevo->vencimientos, n, k, diaFecha(libro->ejemplares[k].fecha));
+        }
+    }
+    for (int j = 0; j < anterior->numEj; j++) {
+        int nodo = viejo->vencimientos.posicion[o][j];
+        if (nodo >= 0 && viejo->vencimientos.nodos[nodo].avisado && ejemplarNuevo[j] >= 0) {
+            marcarAvisado(&nuevo->vencimientos, n, ejemplarNuevo[j]);
+        }
+    }
+    nuevo->esperas[n] = viejo->esperas[o];
+    actualizarResumen(nuevo, n);
+    return agregado;
+}
+
+// Vuelve a armar los índices del nuevo después de agregarle libros que salieron del archivo
+static void reconstruirIndices(struct Catalogo *nuevo) {
+    construirIndiceIsbn(&nuevo->indiceIsbn, nuevo->libros, nuevo->numLibros);
+    liberarIndice(&nuevo->indiceTitulos);
+    if (!construirIndice(&nuevo->indiceTitulos, nuevo->libros, nuevo->numLibros)) {
+        registrar(LOG_ERROR, "No se pudo construir el índice de títulos, las búsquedas no tendrán resultados");
+    }
+}
+
+// Libera un catálogo que ya nadie puede estar leyendo
+void liberarCatalogo(struct Catalogo *cat) {
+    if (!cat) return;
+    liberarIndice(&cat->indiceTitulos);
+    free(cat);
+}
+
+// Entra en lectura y devuelve el catálogo vigente, que no se libera hasta soltarCatalogo.
+// Es para quien lo usa sin mutexLibros (B y C en el hilo principal). Cada lectura toma una casilla
+// libre y la suelta al terminar, así dos lectores nunca comparten una; si las MAX_LECTORES_CATALOGO
+// están ocupadas espera a que se suelte alguna. Sin competencia cuesta dos operaciones atómicas
+struct Catalogo *leerCatalogo(struct Biblioteca *bib) {
+    if (casillaPreferida < 0) {
+        casillaPreferida = atomic_fetch_add(&numLectores, 1) % MAX_LECTORES_CATALOGO;
+    }
+    while (1) {
+        for (int n = 0; n < MAX_LECTORES_CATALOGO; n++) {
+            int k = (casillaPreferida + n) % MAX_LECTORES_CATALOGO;
+            unsigned long libre = 0;
+            if (atomic_compare_exchange_strong(&epocaLectores[k], &libre, atomic_load(&epocaGlobal))) {
+                lectorLocal = k;
+                return atomic_load(&bib->catalogo);
+            }
+        }
+        sched_yield();
+    }
+}
+
+// Sale de lectura y suelta la casilla; el catálogo obtenido con leerCatalogo ya no se puede usar
+void soltarCatalogo(void) {
+    atomic_store(&epocaLectores[lectorLocal], 0);
+    lectorLocal = -1;
+}
+
+// Espera a que ningún lector siga dentro de una lectura que empezó antes de llamarla. Después de
+// publicar un catálogo nuevo, al volver ya nadie puede tener el puntero al viejo
+void esperarLectores(void) {
+    unsigned long nueva = atomic_fetch_add(&epocaGlobal, 1) + 1;
+    for (int k = 0; k < MAX_LECTORES_CATALOGO; k++) {
+        unsigned long epoca;
+        while ((epoca = atomic_load(&epocaLectores[k])) != 0 && epoca < nueva) {
+            usleep(100);
+        }
+    }
+}
+
+// Publica un catálogo armado fuera del mutex (libros y ejemplares, sin estado de préstamos) como
+// el vigente de la biblioteca. Los índices se arman sin mutex y el estado vivo del viejo se pasa
+// libro por libro, tomando mutexLibros solo mientras se copia cada uno, así P, D y R esperan a lo
+// más un libro. Al final, con el mutex, se vuelven a pasar solo los libros que cambiaron desde su
+// copia y se cambia el puntero. El viejo se libera al terminar la espera de los lectores. Debe
+// llamarse con mutexCambios tomado. Devuelve cuántos libros se conservaron del viejo
+int publicarCatalogo(struct Biblioteca *bib, struct Catalogo *nuevo) {
+    if (!construirIndice(&nuevo->indiceTitulos, nuevo->libros, nuevo->numLibros)) {
+        registrar(LOG_ERROR, "No se pudo construir el índice de títulos, las búsquedas no tendrán resultados");
+    }
+    construirIndiceIsbn(&nuevo->indiceIsbn, nuevo->libros, nuevo->numLibros);
+    //Los préstamos que trae el archivo, hasta que los reemplace el estado del libro en el viejo
+    iniciarPrestatarios(&nuevo->prestatarios);
+    iniciarVencimientos(&nuevo->vencimientos);
+    for (int i = 0; i < nuevo->numLibros; i++) {
+        for (int j = 0; j < nuevo->libros[i].numEj; j++) {
+            if (nuevo->libros[i].ejemplares[j].status == 'P') {
+                programarVencimiento(&nuevo->vencimientos, i, j, diaFecha(nuevo->libros[i].ejemplares[j].fecha));
+            }
+        }
+        actualizarResumen(nuevo, i);
+    }
+
+    struct Fusion f;
+    memcpy(f.archivo, nuevo->libros, sizeof(struct Libros) * nuevo->numLibros);
+    f.numArchivo = nuevo->numLibros;
+    //El vigente solo lo cambia quien tiene mutexCambios, así que se puede leer el puntero sin mutexLibros
+    struct Catalogo *viejo = atomic_load(&bib->catalogo);
+    int conservados = 0;
+    for (int o = 0; o < viejo->numLibros; o++) {
+        f.libroNuevo[o] = -1;
+        pthread_mutex_lock(&bib->mutexLibros);
+        conservados += fusionarLibro(nuevo, viejo, &f, o);
+        pthread_mutex_unlock(&bib->mutexLibros);
+    }
+    if (conservados > 0) reconstruirIndices(nuevo);
+
+    pthread_mutex_lock(&bib->mutexLibros);
+    int agregados = 0;
+    for (int o = 0; o < viejo->numLibros; o++) {
+        if (viejo->versionLibro[o] != f.version[o]) {
+            agregados += fusionarLibro(nuevo, viejo, &f, o);
+        }
+    }
+    //Un libro que salió del archivo y recibió una reserva durante la recarga (poco común)
+    if (agregados > 0) reconstruirIndices(nuevo);
+    atomic_store(&bib->catalogo, nuevo);
+    pthread_mutex_unlock(&bib->mutexLibros);
+
+    esperarLectores();
+    liberarCatalogo(viejo);
+    return conservados + agregados;
+}
+
+// Vuelve a leer la base de datos de la biblioteca y publica el catálogo nuevo. La lectura del
+// archivo no toma ningún mutex del catálogo. Devuelve 0 si el archivo no se pudo leer (queda el vigente)
+int recargarBiblioteca(struct Biblioteca *bib) {
+    pthread_mutex_lock(&bib->mutexCambios);
+    struct timespec leido = modificacionArchivo(bib->archivo);
+    struct Catalogo *nuevo = crearCatalogo(bib->archivo);
+    if (!nuevo) {
+        pthread_mutex_unlock(&bib->mutexCambios);
+        registrar(LOG_ERROR, "Recarga de %s: no se pudo leer %s, se mantiene el catálogo vigente", bib->id, bib->archivo);
+        return 0;
+    }
+    bib->archivoLeido = leido;
+    int conservados = publicarCatalogo(bib, nuevo);
+    //Después de soltar mutexCambios otra recarga podría liberar este catálogo
+    int numLibros = nuevo->numLibros;
+    pthread_mutex_unlock(&bib->mutexCambios);
+    registrar(LOG_INFO, "Catálogo de %s recargado desde %s: %d libros (%d conservados por tener préstamos)",
+              bib->id, bib->archivo, numLibros, conservados);
+    return 1;
+}
+
+// Hilo que recarga todas las bibliotecas cada vez que llega SIGHUP. La señal está bloqueada en
+// todos los hilos y solo este la recibe con sigwait, así no se hace nada dentro de un manejador
+void *recargador(void *args) {
+    sigset_t senales;
+    sigemptyset(&senales);
+    sigaddset(&senales, SIGHUP);
+    while (1) {
+        int senal;
+        if (sigwait(&senales, &senal) != 0) continue;
+        //Al terminar el hilo principal manda SIGHUP para despertarlo
+        if (terminar) break;
+        for (int b = 0; b < numBibliotecas; b++) {
+            recargarBiblioteca(&bibliotecas[b]);
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,58 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: catalogo.h
+#	Descripcion: Archivo de encabezado para catalogo.c.
+#                Define el catálogo de una biblioteca como un bloque que se reemplaza completo al
+#                recargar la base de datos, y las funciones de lectura por épocas que permiten
+#                liberar el catálogo viejo cuando ningún lector sin mutex lo está usando
+#****************************************************************/
+
+#ifndef CATALOGO_H
+#define CATALOGO_H
+
+#include <stdatomic.h>
+#include <time.h>
+#include "receptor.h"
+#include "indice.h"
+#include "vencimientos.h"
+#include "prestatarios.h"
+
+#define MAX_LECTORES_CATALOGO 64
+
+// Todo lo que depende de la posición de cada libro en el catálogo. Al recargar se arma uno nuevo
+// y se publica cambiando un solo puntero; quien tenga mutexLibros usa el vigente hasta soltarlo,
+// y quien lo lee sin mutex (B y C) lo pide con leerCatalogo
+struct Catalogo {
+    struct Libros libros[MAX_LIBROS];
+    int numLibros;
+    // Índices de solo lectura para B y C, y el resumen atómico de cada libro para C
+    struct IndiceTitulos indiceTitulos;
+    struct IndiceIsbn indiceIsbn;
+    atomic_ullong resumenLibros[MAX_LIBROS];
+    struct ListaEspera esperas[MAX_LIBROS];
+    struct Vencimientos vencimientos;
+    struct Prestatarios prestatarios;
+    // Sube con cada cambio de un libro (marcarCambio); la recarga vuelve a pasar los que cambiaron
+    unsigned versionLibro[MAX_LIBROS];
+};
+
+struct Biblioteca;
+
+// Funciones del catálogo
+struct timespec modificacionArchivo(const char *archivo);
+struct Catalogo *crearCatalogo(const char *archivo);
+void prepararCatalogo(struct Catalogo *cat);
+void marcarCambio(struct Catalogo *cat, int i);
+void liberarCatalogo(struct Catalogo *cat);
+struct Catalogo *leerCatalogo(struct Biblioteca *bib);
+void soltarCatalogo(void);
+void esperarLectores(void);
+int publicarCatalogo(struct Biblioteca *bib, struct Catalogo *nuevo);
+int recargarBiblioteca(struct Biblioteca *bib);
+void *recargador(void *args);
+
+#endif
@@ -0,0 +1,52 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: codigos.h
+#	Descripcion: Códigos de estado y formato de las respuestas compactas que el receptor manda
+#                para P, D, R y C. El receptor solo escribe el código y los números; el texto
+#                en español lo arma el solicitante
+#****************************************************************/
+
+#ifndef CODIGOS_H
+#define CODIGOS_H
+
+// Primer byte de una respuesta compacta. Ninguna respuesta de texto empieza con él
+#define MARCA_COMPACTA '\x01'
+// Después de la marca va el código y CAMPOS_COMPACTA números sin signo de BYTES_CAMPO bytes cada
+// uno, 7 bits por byte empezando por los más altos y con el bit alto siempre encendido. Así ningún
+// byte es '\0' (fin de la trama) ni '\n' (separador de las líneas de un lote)
+#define CAMPOS_COMPACTA 4
+#define BYTES_CAMPO 4
+#define LARGO_COMPACTA (2 + CAMPOS_COMPACTA * BYTES_CAMPO)
+#define MAX_CAMPO_COMPACTA ((1 << (7 * BYTES_CAMPO)) - 1)
+
+// Los avisos que el solicitante no pidió (reserva asignada o cancelada) empiezan con esta línea,
+// la secuencia 0 que ninguna operación usa. Así no se toman por la respuesta que se está esperando
+#define MARCA_AVISO "s=0\n"
+
+// Códigos de estado con los campos que lleva cada uno (los que no usa van en 0). Las fechas van
+// como aaaammdd. Del RESP_ERROR_NO_ENCONTRADO en adelante son errores
+enum CodigoRespuesta {
+    RESP_PRESTAMO = 1,              // isbn, ejemplar, entrega
+    RESP_DEVOLUCION = 2,            // isbn, ejemplar
+    RESP_RENOVACION = 3,            // isbn, ejemplar, nueva entrega
+    RESP_EN_ESPERA = 4,             // isbn, posición en la lista de espera
+    RESP_RESERVA_ASIGNADA = 5,      // isbn, ejemplar, entrega (aviso)
+    RESP_RESERVA_CANCELADA = 6,     // isbn (aviso al terminar el receptor)
+    RESP_CONSULTA = 7,              // isbn, disponibles, prestados, próxima entrega (0 si no hay)
+    RESP_OCUPADO = 8,               // 0, milisegundos antes de reintentar
+    RESP_ERROR_NO_ENCONTRADO = 32,  // isbn (no existe o el nombre no coincide)
+    RESP_ERROR_SIN_EJEMPLAR = 33,   // isbn
+    RESP_ERROR_SIN_PRESTAMO = 34,   // isbn
+    RESP_ERROR_YA_RESERVADO = 35,   // isbn
+    RESP_ERROR_LISTA_LLENA = 36,    // isbn
+    RESP_ERROR_BIBLIOTECA = 37,     // sin campos
+    RESP_ERROR_ISBN = 38,           // isbn (consulta de un ISBN que no existe)
+    RESP_ERROR_EN_LOTE = 39,        // 0, tipo de operación no permitida en un lote
+    RESP_ERROR_NO_SOPORTADA = 40    // 0, tipo de operación que el receptor no atiende (el unificado solo P, D y R)
+};
+
+#endif
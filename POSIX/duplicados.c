@@ -0,0 +1,127 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: duplicados.c
+#	Descripcion: Ventana de los P, D y R recientes que traen s=cliente:sesion:secuencia. El hilo
+#                principal la revisa antes de encolar una operación y el que la aplica guarda
+#                ahí su respuesta, así un reenvío se contesta sin volver a prestar ni devolver.
+#****************************************************************/
+
+#include <string.h>
+#include <pthread.h>
+#include "duplicados.h"
+#include "metricas.h"
+
+#define NUM_CONJUNTOS (MAX_DUPLICADOS / VIAS_DUPLICADOS)
+
+// Tabla asociativa por conjuntos: cada (cliente, sesión, secuencia) puede quedar en cualquiera de
+// las VIAS_DUPLICADOS casillas de su conjunto
+static struct Duplicado ventana[MAX_DUPLICADOS];
+static pthread_mutex_t mutexVentana = PTHREAD_MUTEX_INITIALIZER;
+
+// Primera casilla del conjunto de una operación. Las secuencias seguidas de una sesión caen en
+// conjuntos seguidos
+static struct Duplicado *conjuntoDe(struct Operaciones *op) {
+    unsigned clave = (unsigned)op->cliente * 2654435761u ^ (unsigned)op->sesion * 40503u;
+    return &ventana[(clave + (unsigned)op->secuencia) % NUM_CONJUNTOS * VIAS_DUPLICADOS];
+}
+
+// Indica si la casilla guarda esta misma operación: la misma clave y el mismo tipo, ISBN y
+// biblioteca. Con la misma clave y otra operación (un solicitante que repitió su -k y su sesión)
+// no es un reenvío y se aplica como nueva
+static int mismaOperacion(const struct Duplicado *d, const struct Operaciones *op) {
+    return d->cliente == op->cliente && d->sesion == op->sesion && d->secuencia == op->secuencia &&
+           d->tipo == op->tipo && d->isbn == op->isbn && d->biblioteca == op->biblioteca;
+}
+
+// Casilla del conjunto con esta operación en curso o respondida, o NULL si no está
+static struct Duplicado *buscarEnConjunto(struct Duplicado *conjunto, struct Operaciones *op) {
+    for (int v = 0; v < VIAS_DUPLICADOS; v++) {
+        if (conjunto[v].estado != DUP_NUEVA && mismaOperacion(&conjunto[v], op)) return &conjunto[v];
+    }
+    return NULL;
+}
+
+// Indica si una respuesta guardada ya no puede pedirse de nuevo: su sesión ya mandó una secuencia
+// posterior (el solicitante no vuelve a una operación anterior) o pasó VIDA_DUPLICADO_MS
+static int fueraDeVentana(const struct Duplicado *d, const struct Operaciones *op, long long ahora) {
+    if (d->cliente == op->cliente && d->sesion == op->sesion && d->secuencia < op->secuencia) return 1;
+    return ahora - d->tRespondida > VIDA_DUPLICADO_MS * 1000000LL;
+}
+
+// Casilla donde registrar una operación nueva: una libre o, si no hay, la respuesta más vieja que
+// ya salió de la ventana. Las que están en curso o todavía pueden reenviarse no se pisan. NULL si
+// no hay ninguna
+static struct Duplicado *casillaLibre(struct Duplicado *conjunto, struct Operaciones *op) {
+    struct Duplicado *elegida = NULL;
+    long long ahora = tiempoNs();
+    for (int v = 0; v < VIAS_DUPLICADOS; v++) {
+        struct Duplicado *d = &conjunto[v];
+        if (d->estado == DUP_NUEVA) return d;
+        if (d->estado == DUP_RESPONDIDA && fueraDeVentana(d, op, ahora) &&
+            (!elegida || d->tRespondida < elegida->tRespondida)) {
+            elegida = d;
+        }
+    }
+    return elegida;
+}
+
+// Busca la operación en la ventana. Si ya se respondió copia la respuesta guardada; si es nueva
+// la registra como en curso. Si su conjunto está lleno de operaciones que todavía pueden
+// reenviarse devuelve DUP_LLENA y no se registra: quien llama la rechaza como ocupado, porque
+// aplicarla sin registro haría que su reenvío se aplicara dos veces. Las operaciones sin
+// secuencia siempre son nuevas
+int revisarDuplicado(struct Operaciones *op, char *respuesta) {
+    if (op->secuencia <= 0) return DUP_NUEVA;
+    struct Duplicado *conjunto = conjuntoDe(op);
+    pthread_mutex_lock(&mutexVentana);
+    int estado = DUP_NUEVA;
+    struct Duplicado *d = buscarEnConjunto(conjunto, op);
+    if (d) {
+        estado = d->estado;
+        if (estado == DUP_RESPONDIDA) {
+            memcpy(respuesta, d->respuesta, sizeof(d->respuesta));
+        }
+    } else if ((d = casillaLibre(conjunto, op)) != NULL) {
+        d->cliente = op->cliente;
+        d->sesion = op->sesion;
+        d->secuencia = op->secuencia;
+        d->tipo = op->tipo;
+        d->isbn = op->isbn;
+        d->biblioteca = op->biblioteca;
+        d->estado = DUP_EN_CURSO;
+    } else {
+        estado = DUP_LLENA;
+    }
+    pthread_mutex_unlock(&mutexVentana);
+    return estado;
+}
+
+// Guarda la respuesta de una operación registrada. Si no está en la ventana no hace nada
+void guardarRespuestaDuplicado(struct Operaciones *op, const char *respuesta) {
+    if (op->secuencia <= 0) return;
+    pthread_mutex_lock(&mutexVentana);
+    struct Duplicado *d = buscarEnConjunto(conjuntoDe(op), op);
+    if (d && d->estado == DUP_EN_CURSO) {
+        strncpy(d->respuesta, respuesta, sizeof(d->respuesta) - 1);
+        d->respuesta[sizeof(d->respuesta) - 1] = '\0';
+        d->tRespondida = tiempoNs();
+        d->estado = DUP_RESPONDIDA;
+    }
+    pthread_mutex_unlock(&mutexVentana);
+}
+
+// Saca de la ventana una operación que no se aplicó (se rechazó por ocupado), para que el
+// reenvío se aplique
+void olvidarDuplicado(struct Operaciones *op) {
+    if (op->secuencia <= 0) return;
+    pthread_mutex_lock(&mutexVentana);
+    struct Duplicado *d = buscarEnConjunto(conjuntoDe(op), op);
+    if (d && d->estado == DUP_EN_CURSO) {
+        d->estado = DUP_NUEVA;
+    }
+    pthread_mutex_unlock(&mutexVentana);
+}
@@ -0,0 +1,51 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: duplicados.h
+#	Descripcion: Archivo de encabezado para duplicados.c.
+#                Define la ventana de operaciones recientes con la que el receptor reconoce un
+#                P, D o R que el solicitante reenvió después de dejar de esperar la respuesta
+#****************************************************************/
+
+#ifndef DUPLICADOS_H
+#define DUPLICADOS_H
+
+#include "protocolo.h"
+
+// Casillas de la ventana. Potencia de 2, repartidas en conjuntos de VIAS_DUPLICADOS casillas
+#define MAX_DUPLICADOS 4096
+// Casillas de cada conjunto: una operación puede quedar en cualquiera de las de su conjunto
+#define VIAS_DUPLICADOS 8
+// Tiempo que una respuesta se guarda para sus reenvíos aunque su casilla haga falta. Cubre de sobra
+// los reenvíos del solicitante (MAX_REINTENTOS_ESPERA con la espera -e)
+#define VIDA_DUPLICADO_MS 30000
+
+// Estado de una operación en la ventana
+#define DUP_NUEVA 0      // No estaba: se registró y hay que aplicarla
+#define DUP_EN_CURSO 1   // Ya se está aplicando; su respuesta llegará con la misma secuencia
+#define DUP_RESPONDIDA 2 // Ya se aplicó; la respuesta guardada quedó en respuesta
+#define DUP_LLENA 3      // No estaba y su conjunto no tiene lugar: se responde ocupado sin aplicarla
+
+// Una operación identificada por (cliente, sesión, secuencia) con la respuesta compacta que se le
+// dio. El tipo, el ISBN y la biblioteca se guardan para no confundirla con otra que traiga la misma clave
+struct Duplicado {
+    int cliente;
+    int sesion;
+    int secuencia;
+    char tipo;
+    int isbn;
+    int biblioteca;
+    int estado;
+    long long tRespondida; // Instante (ns monotónicos) en que se guardó la respuesta
+    char respuesta[LARGO_COMPACTA + 1];
+};
+
+// Funciones de la ventana de duplicados
+int revisarDuplicado(struct Operaciones *op, char *respuesta);
+void guardarRespuestaDuplicado(struct Operaciones *op, const char *respuesta);
+void olvidarDuplicado(struct Operaciones *op);
+
+#endif
@@ -0,0 +1,64 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: grabacion.c
+#	Descripcion: Grabación de las tramas que llegan por el pipe principal (-g). Cada trama se
+#                guarda tal cual con el instante en que se leyó y el pid de su solicitante, así
+#                replay puede volver a mandarlas con el mismo ritmo contra cualquier receptor.
+#****************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include "grabacion.h"
+#include "protocolo.h"
+#include "metricas.h"
+#include "bitacora.h"
+
+#define BUFFER_GRABACION (64 * 1024)
+
+static FILE *archivo = NULL;
+static long long inicio = 0;
+static long tramas = 0;
+
+// Crea el archivo de la grabación y escribe su cabecera. Devuelve 0 si no se pudo crear
+int iniciarGrabacion(const char *nombre) {
+    archivo = fopen(nombre, "wb");
+    if (!archivo) {
+        return 0;
+    }
+    //Con un buffer grande el hilo que lee el pipe casi nunca espera al disco
+    setvbuf(archivo, NULL, _IOFBF, BUFFER_GRABACION);
+    fwrite(MAGIA_GRABACION, 1, LARGO_MAGIA, archivo);
+    inicio = tiempoNs();
+    tramas = 0;
+    return 1;
+}
+
+// Agrega una trama a la grabación. Solo la llama el hilo que lee el pipe principal (el principal
+// o, con el planificador, el lector), así que no necesita mutex
+void grabarTrama(const char *trama, int largo) {
+    if (!archivo || largo <= 0) return;
+    int costo;
+    struct RegistroGrabacion registro;
+    registro.tUs = (tiempoNs() - inicio) / 1000;
+    registro.pid = pidDeTrama(trama, &costo);
+    registro.largo = largo;
+    if (fwrite(&registro, sizeof(registro), 1, archivo) != 1 || fwrite(trama, 1, largo, archivo) != (size_t)largo) {
+        registrar(LOG_ERROR, "No se pudo escribir en la grabación, se detiene");
+        fclose(archivo);
+        archivo = NULL;
+        return;
+    }
+    tramas++;
+}
+
+// Cierra la grabación. Se llama cuando ya nadie lee el pipe principal
+void detenerGrabacion(void) {
+    if (!archivo) return;
+    fclose(archivo);
+    archivo = NULL;
+    registrar(LOG_INFO, "Grabación cerrada con %ld tramas", tramas);
+}
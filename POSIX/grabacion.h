@@ -0,0 +1,33 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: grabacion.h
+#	Descripcion: Archivo de encabezado para grabacion.c y replay.c.
+#                Define el formato del archivo con las tramas que recibió el receptor
+#****************************************************************/
+
+#ifndef GRABACION_H
+#define GRABACION_H
+
+// El archivo empieza con MAGIA_GRABACION y sigue con un registro por trama: la cabecera y después
+// los largo bytes de la trama, sin su '\0'. Los enteros van en el orden de bytes de la máquina
+#define MAGIA_GRABACION "BIBGRAB1"
+#define LARGO_MAGIA 8
+#define MAX_TRAMA_GRABADA 8192
+
+// Cabecera de cada trama grabada
+struct RegistroGrabacion {
+    long long tUs; // Microsegundos desde que empezó la grabación
+    int pid; // Solicitante que mandó la trama (0 si no se pudo leer)
+    int largo;
+};
+
+// Funciones de la grabación (solo el receptor)
+int iniciarGrabacion(const char *nombre);
+void grabarTrama(const char *trama, int largo);
+void detenerGrabacion(void);
+
+#endif
@@ -0,0 +1,232 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: indice.c
+#	Descripcion: Índice invertido de los títulos del catálogo. Se construye una vez después de leerDB;
+#                cada palabra se guarda sin tildes y en minúsculas, y la búsqueda trata cada término
+#                de la consulta como prefijo (una palabra completa es prefijo de sí misma).
+#                Si la consulta trae varios términos se devuelven los libros que tienen todos.
+#                También tiene la tabla de ISBN que usa la consulta C para ubicar un libro sin recorrer el catálogo.
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include "receptor.h"
+#include "indice.h"
+
+// Pasa un texto UTF-8 a minúsculas sin tildes. Las vocales acentuadas, la ñ y la ç (Latin-1 en UTF-8,
+// primer byte 0xC3) se reducen a su letra base; cualquier otro carácter no alfanumérico se vuelve espacio.
+// Devuelve el largo del resultado
+int normalizarTexto(const char *texto, char *salida, size_t tam) {
+    // Letra base para el segundo byte 0x80..0xBF de las secuencias 0xC3 xx
+    static const char base[64] =
+        "aaaaaaaceeeeiiii" "dnooooo ouuuuy  "
+        "aaaaaaaceeeeiiii" "dnooooo ouuuuy y";
+    const unsigned char *p = (const unsigned char *)texto;
+    size_t n = 0;
+    while (*p && n + 1 < tam) {
+        char c;
+        if (p[0] == 0xC3 && p[1] >= 0x80 && p[1] <= 0xBF) {
+            c = base[p[1] - 0x80];
+            p += 2;
+        } else if (p[0] < 0x80) {
+            c = isalnum(p[0]) ? (char)tolower(p[0]) : ' ';
+            p++;
+        } else {
+            // Otros caracteres multibyte se tratan como separadores
+            c = ' ';
+            p++;
+            while ((*p & 0xC0) == 0x80) p++;
+        }
+        salida[n++] = c;
+    }
+    salida[n] = '\0';
+    return (int)n;
+}
+
+// Compara postings por palabra y luego por libro
+static int compararPostings(const void *a, const void *b) {
+    const struct Posting *x = a, *y = b;
+    int c = strcmp(x->palabra, y->palabra);
+    if (c != 0) return c;
+    return (x->libro > y->libro) - (x->libro < y->libro);
+}
+
+// Compara enteros para qsort
+static int compararEnteros(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+// Construye el índice con una entrada por cada palabra distinta de cada título. Devuelve 0 si no hay memoria
+int construirIndice(struct IndiceTitulos *indice, struct Libros *libros, int numLibros) {
+    memset(indice, 0, sizeof(*indice));
+    // Las palabras normalizadas nunca son más largas que los títulos originales
+    size_t total = 0;
+    int maxPalabras = 0;
+    for (int i = 0; i < numLibros; i++) {
+        size_t largo = strlen(libros[i].nombre);
+        total += largo + 1;
+        maxPalabras += (int)largo / 2 + 1;
+    }
+    indice->palabras = malloc(total + 1);
+    indice->postings = malloc(sizeof(struct Posting) * (maxPalabras > 0 ? maxPalabras : 1));
+    if (!indice->palabras || !indice->postings) {
+        liberarIndice(indice);
+        return 0;
+    }
+
+    // Cada título normalizado se parte en palabras dentro de la misma memoria
+    char *cursor = indice->palabras;
+    for (int i = 0; i < numLibros; i++) {
+        int largo = normalizarTexto(libros[i].nombre, cursor, strlen(libros[i].nombre) + 1);
+        char *fin = cursor + largo;
+        char *guardado;
+        char *palabra = strtok_r(cursor, " ", &guardado);
+        while (palabra) {
+            indice->postings[indice->numPostings].palabra = palabra;
+            indice->postings[indice->numPostings].libro = i;
+            indice->numPostings++;
+            palabra = strtok_r(NULL, " ", &guardado);
+        }
+        cursor = fin + 1;
+    }
+
+    // Se ordena y se quitan repetidos (misma palabra dos veces en un título)
+    qsort(indice->postings, indice->numPostings, sizeof(struct Posting), compararPostings);
+    int unicos = 0;
+    for (int k = 0; k < indice->numPostings; k++) {
+        if (unicos > 0 && compararPostings(&indice->postings[unicos - 1], &indice->postings[k]) == 0) continue;
+        indice->postings[unicos++] = indice->postings[k];
+    }
+    indice->numPostings = unicos;
+    return 1;
+}
+
+// Primer posting cuya palabra es mayor o igual al prefijo
+static int primerPosting(const struct IndiceTitulos *indice, const char *prefijo) {
+    int lo = 0, hi = indice->numPostings;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (strcmp(indice->postings[mid].palabra, prefijo) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+// Libros (ordenados y sin repetir) con alguna palabra que empiece con el prefijo
+static int librosConPrefijo(const struct IndiceTitulos *indice, const char *prefijo, int **libros) {
+    size_t largo = strlen(prefijo);
+    int desde = primerPosting(indice, prefijo);
+    int hasta = desde;
+    while (hasta < indice->numPostings && strncmp(indice->postings[hasta].palabra, prefijo, largo) == 0) {
+        hasta++;
+    }
+    *libros = malloc(sizeof(int) * (hasta - desde + 1));
+    if (!*libros) return 0;
+    int n = 0;
+    for (int k = desde; k < hasta; k++) {
+        (*libros)[n++] = indice->postings[k].libro;
+    }
+    qsort(*libros, n, sizeof(int), compararEnteros);
+    int unicos = 0;
+    for (int k = 0; k < n; k++) {
+        if (unicos == 0 || (*libros)[unicos - 1] != (*libros)[k]) {
+            (*libros)[unicos++] = (*libros)[k];
+        }
+    }
+    return unicos;
+}
+
+// Busca los libros cuyo título tiene todos los términos de la consulta (como prefijos).
+// Copia en resultados hasta maxResultados índices de libro a partir de la posición desde y
+// devuelve el total de coincidencias. Con desde negativo no copia nada
+int buscarTitulos(const struct IndiceTitulos *indice, const char *consulta, int desde, int *resultados, int maxResultados) {
+    char normalizada[256];
+    normalizarTexto(consulta, normalizada, sizeof(normalizada));
+
+    int *coincidencias = NULL;
+    int total = 0, terminos = 0;
+    char *guardado;
+    for (char *termino = strtok_r(normalizada, " ", &guardado); termino && terminos < MAX_TERMINOS;
+         termino = strtok_r(NULL, " ", &guardado), terminos++) {
+        int *libros;
+        int n = librosConPrefijo(indice, termino, &libros);
+        if (terminos == 0) {
+            coincidencias = libros;
+            total = n;
+            continue;
+        }
+        // Intersección de dos listas ordenadas
+        int a = 0, b = 0, k = 0;
+        while (a < total && b < n) {
+            if (coincidencias[a] < libros[b]) {
+                a++;
+            } else if (coincidencias[a] > libros[b]) {
+                b++;
+            } else {
+                coincidencias[k++] = coincidencias[a];
+                a++;
+                b++;
+            }
+        }
+        total = k;
+        free(libros);
+    }
+
+    for (int k = desde; k >= 0 && k < total && k - desde < maxResultados; k++) {
+        resultados[k - desde] = coincidencias[k];
+    }
+    free(coincidencias);
+    return total;
+}
+
+// Libera la memoria del índice
+void liberarIndice(struct IndiceTitulos *indice) {
+    free(indice->postings);
+    free(indice->palabras);
+    indice->postings = NULL;
+    indice->palabras = NULL;
+    indice->numPostings = 0;
+}
+
+// Casilla inicial de un ISBN en la tabla (hash multiplicativo)
+static unsigned casillaIsbn(int isbn) {
+    return ((unsigned)isbn * 2654435761u) >> 24 & (TAM_TABLA_ISBN - 1);
+}
+
+// Llena la tabla de ISBN con la posición de cada libro en el catálogo
+void construirIndiceIsbn(struct IndiceIsbn *indice, struct Libros *libros, int numLibros) {
+    for (int k = 0; k < TAM_TABLA_ISBN; k++) {
+        indice->libro[k] = -1;
+    }
+    for (int i = 0; i < numLibros; i++) {
+        unsigned k = casillaIsbn(libros[i].isbn);
+        while (indice->libro[k] != -1 && indice->isbn[k] != libros[i].isbn) {
+            k = (k + 1) & (TAM_TABLA_ISBN - 1);
+        }
+        // Si el ISBN se repite se queda la primera aparición, igual que en las búsquedas lineales
+        if (indice->libro[k] == -1) {
+            indice->isbn[k] = libros[i].isbn;
+            indice->libro[k] = i;
+        }
+    }
+}
+
+// Devuelve la posición del libro con ese ISBN o -1 si no existe
+int buscarIsbn(const struct IndiceIsbn *indice, int isbn) {
+    unsigned k = casillaIsbn(isbn);
+    while (indice->libro[k] != -1) {
+        if (indice->isbn[k] == isbn) return indice->libro[k];
+        k = (k + 1) & (TAM_TABLA_ISBN - 1);
+    }
+    return -1;
+}
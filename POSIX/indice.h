@@ -0,0 +1,54 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: indice.h
+#	Descripcion: Archivo de encabezado para indice.c.
+#                Define el índice invertido de palabras de los títulos usado por la operación B (buscar)
+#                y la tabla de ISBN usada por la consulta C
+#****************************************************************/
+
+#ifndef INDICE_H
+#define INDICE_H
+
+#include <stddef.h>
+
+#define TAM_PAGINA 10
+#define MAX_TERMINOS 8
+// Potencia de 2 mayor al doble de MAX_LIBROS, así la tabla nunca pasa de la mitad llena
+#define TAM_TABLA_ISBN 256
+
+struct Libros;
+
+// Aparición de una palabra (ya normalizada) en el título de un libro
+struct Posting {
+    const char *palabra;
+    int libro;
+};
+
+// Índice invertido: postings ordenados por palabra y luego por libro, así todas las
+// palabras que empiezan con un prefijo quedan contiguas y se encuentran con búsqueda binaria
+struct IndiceTitulos {
+    struct Posting *postings;
+    int numPostings;
+    char *palabras; // Memoria donde viven las palabras normalizadas
+};
+
+// Tabla hash de direccionamiento abierto de ISBN a posición en el catálogo. Se llena al cargar
+// y después solo se lee, por eso se puede consultar desde cualquier hilo sin mutex
+struct IndiceIsbn {
+    int isbn[TAM_TABLA_ISBN];
+    int libro[TAM_TABLA_ISBN]; // -1 si la casilla está vacía
+};
+
+// Funciones del índice
+int normalizarTexto(const char *texto, char *salida, size_t tam);
+int construirIndice(struct IndiceTitulos *indice, struct Libros *libros, int numLibros);
+int buscarTitulos(const struct IndiceTitulos *indice, const char *consulta, int desde, int *resultados, int maxResultados);
+void liberarIndice(struct IndiceTitulos *indice);
+void construirIndiceIsbn(struct IndiceIsbn *indice, struct Libros *libros, int numLibros);
+int buscarIsbn(const struct IndiceIsbn *indice, int isbn);
+
+#endif
@@ -0,0 +1,238 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: metricas.c
+#	Descripcion: Métricas en vivo del receptor. Cada hilo acumula sus contadores y su histograma de
+#                latencia en su propia estructura (sin locks); al consultarlas se suman todas.
+#                Se exponen en formato de texto estilo Prometheus.
+#****************************************************************/
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "receptor.h"
+#include "metricas.h"
+#include "bitacora.h"
+
+// Contadores de cada hilo y cuántos hilos se han registrado
+static struct MetricasHilo metricasHilos[MAX_HILOS_METRICAS];
+static atomic_int numHilosMetricas = 0;
+// Contadores del hilo actual, se asignan la primera vez que el hilo registra algo
+static __thread struct MetricasHilo *metricasLocal = NULL;
+
+// Máxima profundidad que ha alcanzado el buffer (todos los carriles de una biblioteca)
+atomic_int bufferMax = 0;
+// Reintentos y fallos de los escritores de respuestas
+atomic_ulong respuestaReintentos = 0;
+atomic_ulong respuestaFallosApertura = 0;
+atomic_ulong respuestaFallosEscritura = 0;
+// Respuestas descartadas porque la cola de salida del solicitante estaba llena y las que esperan escritor
+atomic_ulong respuestasDescartadas = 0;
+atomic_int respuestasPendientes = 0;
+// Respuestas entregadas y llamadas al sistema de los escritores (open y writev; cada open tiene su close)
+atomic_ulong respuestasEscritas = 0;
+atomic_ulong respuestaAperturas = 0;
+atomic_ulong respuestaEscrituras = 0;
+// Reservas estacionadas en las listas de espera y cuántas se han asignado en una devolución
+atomic_int reservasEnEspera = 0;
+atomic_ulong reservasAsignadas = 0;
+// Operaciones rechazadas con "ocupado" porque su carril llegó a la marca (-H) o su cola del planificador se llenó
+atomic_ulong operacionesRechazadas = 0;
+// Reenvíos de un P, D o R que ya estaba en la ventana de duplicados y no se volvieron a aplicar
+atomic_ulong operacionesRepetidas = 0;
+// Máxima espera observada en cada carril
+atomic_ulong esperaMaxUs[NUM_CARRILES_METRICAS];
+// Nombres de los carriles en las métricas, en el orden de CARRIL_*
+static const char *nombresCarriles[NUM_CARRILES_METRICAS] = {"devoluciones", "prestamos", "admin", "consultas"};
+
+// Devuelve el tiempo monotónico actual en nanosegundos
+long long tiempoNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Devuelve los contadores del hilo actual, registrándolo si es la primera vez.
+// Si hay más hilos que espacios, los sobrantes comparten el último (siguen siendo atómicos)
+static struct MetricasHilo *metricasDelHilo(void) {
+    if (!metricasLocal) {
+        int slot = atomic_fetch_add(&numHilosMetricas, 1);
+        if (slot >= MAX_HILOS_METRICAS) {
+            slot = MAX_HILOS_METRICAS - 1;
+        }
+        metricasLocal = &metricasHilos[slot];
+    }
+    return metricasLocal;
+}
+
+// Cubeta de una duración: la primera potencia de 2 (en us) mayor o igual a ella
+static int cubetaDe(unsigned long us) {
+    int cubeta = 0;
+    while (cubeta < NUM_CUBETAS - 1 && (1UL << cubeta) < us) {
+        cubeta++;
+    }
+    return cubeta;
+}
+
+// Registra el resultado de una operación y su latencia desde que se leyó del pipe
+void registrarOperacion(char tipo, int exito, long long tIngreso) {
+    const char *pos = strchr(TIPOS_METRICAS, tipo);
+    if (!pos || tipo == '\0') return;
+    int t = pos - TIPOS_METRICAS;
+    struct MetricasHilo *m = metricasDelHilo();
+
+    if (exito) {
+        atomic_fetch_add_explicit(&m->exitos[t], 1, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&m->fallos[t], 1, memory_order_relaxed);
+    }
+    if (tIngreso <= 0) return;
+
+    unsigned long us = (unsigned long)((tiempoNs() - tIngreso) / 1000);
+    int cubeta = cubetaDe(us);
+    atomic_fetch_add_explicit(&m->cubetas[t][cubeta], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&m->sumaUs[t], us, memory_order_relaxed);
+}
+
+// Registra cuánto esperó una operación en su carril (para las consultas, desde que se leyó del pipe
+// hasta que el hilo principal la atiende)
+void registrarEspera(int carril, long long tEncolado) {
+    if (carril < 0 || carril >= NUM_CARRILES_METRICAS || tEncolado <= 0) return;
+    struct MetricasHilo *m = metricasDelHilo();
+    unsigned long us = (unsigned long)((tiempoNs() - tEncolado) / 1000);
+    atomic_fetch_add_explicit(&m->esperaCubetas[carril][cubetaDe(us)], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&m->esperaSumaUs[carril], us, memory_order_relaxed);
+    unsigned long maximo = atomic_load_explicit(&esperaMaxUs[carril], memory_order_relaxed);
+    while (us > maximo &&
+           !atomic_compare_exchange_weak_explicit(&esperaMaxUs[carril], &maximo, us, memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+// Actualiza la máxima profundidad observada del buffer
+void registrarProfundidad(int profundidad) {
+    int actual = atomic_load_explicit(&bufferMax, memory_order_relaxed);
+    while (profundidad > actual &&
+           !atomic_compare_exchange_weak_explicit(&bufferMax, &actual, profundidad, memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+// Suma los contadores de todos los hilos y los imprime en formato de texto estilo Prometheus
+void imprimirMetricas(FILE *salida) {
+    int hilos = atomic_load(&numHilosMetricas);
+    if (hilos > MAX_HILOS_METRICAS) hilos = MAX_HILOS_METRICAS;
+
+    fprintf(salida, "# TYPE biblioteca_operaciones_total counter\n");
+    for (int t = 0; t < NUM_TIPOS_METRICAS; t++) {
+        unsigned long exitos = 0, fallos = 0;
+        for (int h = 0; h < hilos; h++) {
+            exitos += atomic_load_explicit(&metricasHilos[h].exitos[t], memory_order_relaxed);
+            fallos += atomic_load_explicit(&metricasHilos[h].fallos[t], memory_order_relaxed);
+        }
+        fprintf(salida, "biblioteca_operaciones_total{tipo=\"%c\",resultado=\"exito\"} %lu\n", TIPOS_METRICAS[t], exitos);
+        fprintf(salida, "biblioteca_operaciones_total{tipo=\"%c\",resultado=\"fallo\"} %lu\n", TIPOS_METRICAS[t], fallos);
+    }
+
+    fprintf(salida, "# TYPE biblioteca_latencia_us histogram\n");
+    for (int t = 0; t < NUM_TIPOS_METRICAS; t++) {
+        unsigned long acumulado = 0, suma = 0;
+        for (int c = 0; c < NUM_CUBETAS; c++) {
+            for (int h = 0; h < hilos; h++) {
+                acumulado += atomic_load_explicit(&metricasHilos[h].cubetas[t][c], memory_order_relaxed);
+            }
+            if (c < NUM_CUBETAS - 1) {
+                fprintf(salida, "biblioteca_latencia_us_bucket{tipo=\"%c\",le=\"%lu\"} %lu\n", TIPOS_METRICAS[t], 1UL << c, acumulado);
+            } else {
+                fprintf(salida, "biblioteca_latencia_us_bucket{tipo=\"%c\",le=\"+Inf\"} %lu\n", TIPOS_METRICAS[t], acumulado);
+            }
+        }
+        for (int h = 0; h < hilos; h++) {
+            suma += atomic_load_explicit(&metricasHilos[h].sumaUs[t], memory_order_relaxed);
+        }
+        fprintf(salida, "biblioteca_latencia_us_sum{tipo=\"%c\"} %lu\n", TIPOS_METRICAS[t], suma);
+        fprintf(salida, "biblioteca_latencia_us_count{tipo=\"%c\"} %lu\n", TIPOS_METRICAS[t], acumulado);
+    }
+
+    fprintf(salida, "# TYPE biblioteca_carril_espera_us histogram\n");
+    for (int c = 0; c < NUM_CARRILES_METRICAS; c++) {
+        unsigned long acumulado = 0, suma = 0;
+        for (int k = 0; k < NUM_CUBETAS; k++) {
+            for (int h = 0; h < hilos; h++) {
+                acumulado += atomic_load_explicit(&metricasHilos[h].esperaCubetas[c][k], memory_order_relaxed);
+            }
+            if (k < NUM_CUBETAS - 1) {
+                fprintf(salida, "biblioteca_carril_espera_us_bucket{carril=\"%s\",le=\"%lu\"} %lu\n", nombresCarriles[c], 1UL << k, acumulado);
+            } else {
+                fprintf(salida, "biblioteca_carril_espera_us_bucket{carril=\"%s\",le=\"+Inf\"} %lu\n", nombresCarriles[c], acumulado);
+            }
+        }
+        for (int h = 0; h < hilos; h++) {
+            suma += atomic_load_explicit(&metricasHilos[h].esperaSumaUs[c], memory_order_relaxed);
+        }
+        fprintf(salida, "biblioteca_carril_espera_us_sum{carril=\"%s\"} %lu\n", nombresCarriles[c], suma);
+        fprintf(salida, "biblioteca_carril_espera_us_count{carril=\"%s\"} %lu\n", nombresCarriles[c], acumulado);
+    }
+    fprintf(salida, "# TYPE biblioteca_carril_espera_max_us gauge\n");
+    for (int c = 0; c < NUM_CARRILES_METRICAS; c++) {
+        fprintf(salida, "biblioteca_carril_espera_max_us{carril=\"%s\"} %lu\n", nombresCarriles[c], atomic_load(&esperaMaxUs[c]));
+    }
+
+    fprintf(salida, "# TYPE biblioteca_buffer_profundidad_max gauge\n");
+    fprintf(salida, "biblioteca_buffer_profundidad_max %d\n", atomic_load(&bufferMax));
+    fprintf(salida, "# TYPE biblioteca_rechazadas_ocupado_total counter\n");
+    fprintf(salida, "biblioteca_rechazadas_ocupado_total %lu\n", atomic_load(&operacionesRechazadas));
+    fprintf(salida, "# TYPE biblioteca_reenvios_repetidos_total counter\n");
+    fprintf(salida, "biblioteca_reenvios_repetidos_total %lu\n", atomic_load(&operacionesRepetidas));
+    fprintf(salida, "# TYPE biblioteca_respuesta_reintentos_total counter\n");
+    fprintf(salida, "biblioteca_respuesta_reintentos_total %lu\n", atomic_load(&respuestaReintentos));
+    fprintf(salida, "# TYPE biblioteca_respuesta_fallos_total counter\n");
+    fprintf(salida, "biblioteca_respuesta_fallos_total{causa=\"apertura\"} %lu\n", atomic_load(&respuestaFallosApertura));
+    fprintf(salida, "biblioteca_respuesta_fallos_total{causa=\"escritura\"} %lu\n", atomic_load(&respuestaFallosEscritura));
+    fprintf(salida, "# TYPE biblioteca_respuestas_escritas_total counter\n");
+    fprintf(salida, "biblioteca_respuestas_escritas_total %lu\n", atomic_load(&respuestasEscritas));
+    fprintf(salida, "# TYPE biblioteca_respuesta_llamadas_total counter\n");
+    fprintf(salida, "biblioteca_respuesta_llamadas_total{llamada=\"open\"} %lu\n", atomic_load(&respuestaAperturas));
+    fprintf(salida, "biblioteca_respuesta_llamadas_total{llamada=\"close\"} %lu\n", atomic_load(&respuestaAperturas));
+    fprintf(salida, "biblioteca_respuesta_llamadas_total{llamada=\"writev\"} %lu\n", atomic_load(&respuestaEscrituras));
+    fprintf(salida, "# TYPE biblioteca_respuestas_descartadas_total counter\n");
+    fprintf(salida, "biblioteca_respuestas_descartadas_total %lu\n", atomic_load(&respuestasDescartadas));
+    fprintf(salida, "# TYPE biblioteca_respuestas_pendientes gauge\n");
+    fprintf(salida, "biblioteca_respuestas_pendientes %d\n", atomic_load(&respuestasPendientes));
+    fprintf(salida, "# TYPE biblioteca_reservas_en_espera gauge\n");
+    fprintf(salida, "biblioteca_reservas_en_espera %d\n", atomic_load(&reservasEnEspera));
+    fprintf(salida, "# TYPE biblioteca_reservas_asignadas_total counter\n");
+    fprintf(salida, "biblioteca_reservas_asignadas_total %lu\n", atomic_load(&reservasAsignadas));
+    fprintf(salida, "# TYPE biblioteca_log_descartados_total counter\n");
+    fprintf(salida, "biblioteca_log_descartados_total %lu\n", atomic_load(&logDescartados));
+}
+
+// Escribe las métricas en el archivo de estadísticas. Se escribe en un temporal y se renombra
+// para que quien lo lea nunca vea un archivo a medio escribir
+void guardarMetricas(const char *fileStats) {
+    char temporal[300];
+    snprintf(temporal, sizeof(temporal), "%s.tmp", fileStats);
+    FILE *salida = fopen(temporal, "w");
+    if (!salida) {
+        printf("Error al crear el archivo de estadísticas %s\n", fileStats);
+        return;
+    }
+    imprimirMetricas(salida);
+    fclose(salida);
+    rename(temporal, fileStats);
+}
+
+// Hilo que escribe periódicamente el archivo de estadísticas hasta que se marque terminar
+void *escritorMetricas(void *args) {
+    const char *fileStats = (const char *)args;
+    while (!terminar) {
+        // Se duerme en pasos cortos para notar rápido la terminación
+        for (int i = 0; i < INTERVALO_METRICAS * 10 && !terminar; i++) {
+            usleep(100000);
+        }
+        guardarMetricas(fileStats);
+    }
+    return NULL;
+}
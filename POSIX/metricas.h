@@ -0,0 +1,65 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: metricas.h
+#	Descripcion: Archivo de encabezado para metricas.c.
+#                Define los contadores por hilo, los histogramas de latencia y de espera por carril y las funciones para
+#                consultarlos desde consola (comando m) o escribirlos en un archivo de estadísticas
+#****************************************************************/
+
+#ifndef METRICAS_H
+#define METRICAS_H
+
+#include <stdio.h>
+#include <stdatomic.h>
+#include "receptor.h"
+
+#define MAX_HILOS_METRICAS 64
+// Cubetas en potencias de 2 de microsegundos: <=1us, <=2us, ..., <=2^(NUM_CUBETAS-2)us y +Inf
+#define NUM_CUBETAS 24
+#define INTERVALO_METRICAS 1
+// Tipos de operación con contadores propios, en el orden de los índices
+#define TIPOS_METRICAS "PRDQBCLA"
+#define NUM_TIPOS_METRICAS 8
+
+// Contadores de un solo hilo. Solo ese hilo escribe, así no hay contención entre hilos;
+// se alinean a línea de caché para no compartirla con los de otro hilo
+struct MetricasHilo {
+    atomic_ulong exitos[NUM_TIPOS_METRICAS];
+    atomic_ulong fallos[NUM_TIPOS_METRICAS];
+    atomic_ulong cubetas[NUM_TIPOS_METRICAS][NUM_CUBETAS];
+    atomic_ulong sumaUs[NUM_TIPOS_METRICAS];
+    // Espera en cada carril, desde que la operación entra hasta que un hilo la saca
+    atomic_ulong esperaCubetas[NUM_CARRILES_METRICAS][NUM_CUBETAS];
+    atomic_ulong esperaSumaUs[NUM_CARRILES_METRICAS];
+} __attribute__((aligned(64)));
+
+// Contadores globales que no dependen del hilo
+extern atomic_int bufferMax;
+extern atomic_ulong respuestaReintentos;
+extern atomic_ulong respuestaFallosApertura;
+extern atomic_ulong respuestaFallosEscritura;
+extern atomic_ulong respuestasDescartadas;
+extern atomic_ulong respuestasEscritas;
+extern atomic_ulong respuestaAperturas;
+extern atomic_ulong respuestaEscrituras;
+extern atomic_int respuestasPendientes;
+extern atomic_int reservasEnEspera;
+extern atomic_ulong reservasAsignadas;
+extern atomic_ulong operacionesRechazadas;
+extern atomic_ulong operacionesRepetidas;
+extern atomic_ulong esperaMaxUs[NUM_CARRILES_METRICAS];
+
+// Funciones de métricas
+long long tiempoNs(void);
+void registrarOperacion(char tipo, int exito, long long tIngreso);
+void registrarEspera(int carril, long long tEncolado);
+void registrarProfundidad(int profundidad);
+void imprimirMetricas(FILE *salida);
+void guardarMetricas(const char *fileStats);
+void *escritorMetricas(void *args);
+
+#endif
@@ -0,0 +1,254 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: planificador.c
+#	Descripcion: Reparto justo del pipe principal entre solicitantes. Un hilo lector saca las
+#                tramas del pipe y las deja en una cola por pid; el hilo principal las toma por
+#                turnos con déficit (cada turno vale quantum operaciones, un lote cuesta n) y cada
+#                solicitante gasta fichas de un balde que se recarga a una tasa fija, así un
+#                solicitante con un archivo enorme no deja sin atender a los interactivos.
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <limits.h>
+#include "planificador.h"
+#include "receptor.h"
+#include "metricas.h"
+#include "bitacora.h"
+#include "respuestas.h"
+
+static struct Planificador plan;
+static int activo = 0;
+
+// Prepara las colas. tasa son operaciones por segundo por solicitante (0 sin límite) y rafaga las
+// fichas que puede acumular; quantum son las operaciones que gana cada solicitante por turno
+void iniciarPlanificador(double tasa, double rafaga, int quantum) {
+    memset(&plan, 0, sizeof(plan));
+    pthread_mutex_init(&plan.mutex, NULL);
+    // La espera por fichas se mide con el reloj monotónico, igual que tIngreso
+    pthread_condattr_t atributos;
+    pthread_condattr_init(&atributos);
+    pthread_condattr_setclock(&atributos, CLOCK_MONOTONIC);
+    pthread_cond_init(&plan.hayTramas, &atributos);
+    pthread_condattr_destroy(&atributos);
+    plan.tasa = tasa;
+    plan.rafaga = rafaga;
+    plan.quantum = quantum;
+    activo = 1;
+}
+
+// 1 si el hilo principal toma las tramas del planificador en lugar de leer el pipe
+int planificadorActivo(void) {
+    return activo;
+}
+
+// Recarga las fichas de una cola hasta el instante ahora
+static void recargar(struct ColaCliente *c, long long ahora) {
+    if (plan.tasa <= 0) return;
+    c->fichas += (ahora - c->recarga) / 1e9 * plan.tasa;
+    if (c->fichas > plan.rafaga) c->fichas = plan.rafaga;
+    c->recarga = ahora;
+}
+
+// Cola del pid o una libre para él. Una casilla sin tramas se reutiliza cuando su balde ya se llenó,
+// así nadie recupera fichas antes de tiempo por quedarse sin tramas. Devuelve NULL si no hay espacio
+static struct ColaCliente *buscarCola(int pid, long long ahora) {
+    struct ColaCliente *libre = NULL;
+    for (int k = 0; k < MAX_CLIENTES_PLAN; k++) {
+        struct ColaCliente *c = &plan.clientes[k];
+        if (c->ocupada && c->pid == pid) return c;
+        if (libre) continue;
+        if (!c->ocupada) {
+            libre = c;
+        } else if (c->cont == 0) {
+            recargar(c, ahora);
+            if (plan.tasa <= 0 || c->fichas >= plan.rafaga) libre = c;
+        }
+    }
+    if (libre) {
+        memset(libre, 0, sizeof(*libre));
+        libre->pid = pid;
+        libre->ocupada = 1;
+        libre->fichas = plan.rafaga;
+        libre->recarga = ahora;
+    }
+    return libre;
+}
+
+// Deja una trama recién leída del pipe en la cola de su solicitante. Si la cola está llena se le
+// responde que está ocupado, con el tiempo que tardaría en vaciarse a su tasa
+void encolarTrama(const char *trama, int largo, long long tIngreso) {
+    char *copia = malloc(largo + 1);
+    if (!copia) {
+        registrar(LOG_ERROR, "No se pudo reservar memoria para una trama, se descarta");
+        return;
+    }
+    memcpy(copia, trama, largo);
+    copia[largo] = '\0';
+
+    pthread_mutex_lock(&plan.mutex);
+    //La Q se guarda aparte para atenderla después de lo que ya está en cola
+    if (trama[0] == 'Q' && trama[1] == ',') {
+        if (!plan.salida) {
+            plan.salida = copia;
+            plan.ingresoSalida = tIngreso;
+            copia = NULL;
+        }
+        pthread_cond_signal(&plan.hayTramas);
+        pthread_mutex_unlock(&plan.mutex);
+        free(copia);
+        return;
+    }
+    int costo;
+    int pid = pidDeTrama(trama, &costo);
+    struct ColaCliente *c = buscarCola(pid, tIngreso);
+    if (!c || c->cont == MAX_COLA_CLIENTE) {
+        long espera = plan.tasa > 0 && c ? (long)(c->cont * 1000 / plan.tasa) : MIN_REINTENTO_MS * 10;
+        pthread_mutex_unlock(&plan.mutex);
+        free(copia);
+        if (espera < MIN_REINTENTO_MS) espera = MIN_REINTENTO_MS;
+        if (espera > MAX_REINTENTO_MS) espera = MAX_REINTENTO_MS;
+        char respuesta[LARGO_COMPACTA + 1];
+        armarRespuesta(respuesta, RESP_OCUPADO, 0, espera, 0, 0);
+        atomic_fetch_add(&operacionesRechazadas, 1);
+        enviarRespuesta(pid, respuesta);
+        return;
+    }
+    int pos = (c->inicio + c->cont) % MAX_COLA_CLIENTE;
+    c->tramas[pos] = copia;
+    c->costos[pos] = costo;
+    c->ingresos[pos] = tIngreso;
+    //Una cola que estaba vacía entra al final del anillo de turnos
+    if (c->cont++ == 0) {
+        plan.activas[plan.numActivas++] = c - plan.clientes;
+    }
+    pthread_cond_signal(&plan.hayTramas);
+    pthread_mutex_unlock(&plan.mutex);
+}
+
+// Entrega al hilo principal la siguiente trama por turnos con déficit. Cada cola, al empezar su
+// turno, gana quantum operaciones de déficit y entrega tramas mientras le alcance; una cola sin
+// fichas pierde el turno. Si ninguna tiene fichas se espera a la primera que las junte. Devuelve
+// el largo de la trama o -1 al terminar
+int siguienteTramaPlanificada(char *trama, int tam, long long *tIngreso) {
+    pthread_mutex_lock(&plan.mutex);
+    while (1) {
+        if (terminar) break;
+        if (plan.numActivas == 0) {
+            if (plan.salida) {
+                char *salida = plan.salida;
+                plan.salida = NULL;
+                *tIngreso = plan.ingresoSalida;
+                pthread_mutex_unlock(&plan.mutex);
+                snprintf(trama, tam, "%s", salida);
+                free(salida);
+                return strlen(trama);
+            }
+            if (plan.cerrado) break;
+            pthread_cond_wait(&plan.hayTramas, &plan.mutex);
+            continue;
+        }
+
+        long long ahora = tiempoNs();
+        long long espera = LLONG_MAX;
+        int sinFichas = 0;
+        while (sinFichas < plan.numActivas) {
+            if (plan.turno >= plan.numActivas) plan.turno = 0;
+            struct ColaCliente *c = &plan.clientes[plan.activas[plan.turno]];
+            int costo = c->costos[c->inicio];
+            recargar(c, ahora);
+            //Un lote más grande que la ráfaga pasa con la ráfaga llena y deja el balde en negativo
+            double necesarias = costo < plan.rafaga ? costo : plan.rafaga;
+            if (plan.tasa > 0 && c->fichas < necesarias) {
+                long long falta = (long long)((necesarias - c->fichas) / plan.tasa * 1e9);
+                if (falta < espera) espera = falta;
+                c->enTurno = 0;
+                plan.turno++;
+                sinFichas++;
+                continue;
+            }
+            sinFichas = 0;
+            if (!c->enTurno) {
+                c->deficit += plan.quantum;
+                c->enTurno = 1;
+            }
+            if (costo > c->deficit) {
+                c->enTurno = 0;
+                plan.turno++;
+                continue;
+            }
+            //Se entrega la primera trama de la cola; la cola sigue en su turno mientras le alcance el déficit
+            char *elegida = c->tramas[c->inicio];
+            *tIngreso = c->ingresos[c->inicio];
+            c->inicio = (c->inicio + 1) % MAX_COLA_CLIENTE;
+            c->cont--;
+            c->deficit -= costo;
+            if (plan.tasa > 0) c->fichas -= costo;
+            if (c->cont == 0) {
+                memmove(&plan.activas[plan.turno], &plan.activas[plan.turno + 1], sizeof(int) * (plan.numActivas - plan.turno - 1));
+                plan.numActivas--;
+                c->deficit = 0;
+                c->enTurno = 0;
+            }
+            pthread_mutex_unlock(&plan.mutex);
+            snprintf(trama, tam, "%s", elegida);
+            free(elegida);
+            return strlen(trama);
+        }
+
+        //Nadie tiene fichas: se espera a que alguien las junte o a que llegue una trama nueva
+        struct timespec limite;
+        clock_gettime(CLOCK_MONOTONIC, &limite);
+        long long ns = limite.tv_nsec + espera;
+        limite.tv_sec += ns / 1000000000LL;
+        limite.tv_nsec = ns % 1000000000LL;
+        pthread_cond_timedwait(&plan.hayTramas, &plan.mutex, &limite);
+    }
+    pthread_mutex_unlock(&plan.mutex);
+    return -1;
+}
+
+// Marca que no llegarán más tramas y despierta al hilo principal (al terminar o si el pipe falla)
+void cerrarPlanificador(void) {
+    if (!activo) return;
+    pthread_mutex_lock(&plan.mutex);
+    plan.cerrado = 1;
+    pthread_cond_broadcast(&plan.hayTramas);
+    pthread_mutex_unlock(&plan.mutex);
+}
+
+// Libera las tramas que quedaron sin atender
+void liberarPlanificador(void) {
+    if (!activo) return;
+    for (int k = 0; k < MAX_CLIENTES_PLAN; k++) {
+        struct ColaCliente *c = &plan.clientes[k];
+        for (int i = 0; i < c->cont; i++) {
+            free(c->tramas[(c->inicio + i) % MAX_COLA_CLIENTE]);
+        }
+    }
+    free(plan.salida);
+    pthread_mutex_destroy(&plan.mutex);
+    pthread_cond_destroy(&plan.hayTramas);
+    activo = 0;
+}
+
+// Hilo que lee el pipe principal y reparte las tramas en las colas. Al terminar el hilo principal
+// le escribe una trama vacía al pipe para despertarlo
+void *lectorTramas(void *args) {
+    int fd = *(int *)args;
+    char trama[2 * PIPE_BUF];
+    while (!terminar) {
+        int largo = siguienteTrama(fd, trama, sizeof(trama), NULL);
+        if (largo < 0 || terminar) break;
+        if (largo == 0) continue;
+        encolarTrama(trama, largo, tiempoNs());
+    }
+    cerrarPlanificador();
+    return NULL;
+}
@@ -0,0 +1,67 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: planificador.h
+#	Descripcion: Archivo de encabezado para planificador.c.
+#                Define las colas por solicitante, el balde de fichas de cada una y el turno
+#                rotativo con déficit con el que el hilo principal toma las tramas del pipe
+#****************************************************************/
+
+#ifndef PLANIFICADOR_H
+#define PLANIFICADOR_H
+
+#include <pthread.h>
+
+// Solicitantes con tramas en cola a la vez y tramas en cola por solicitante
+#define MAX_CLIENTES_PLAN 256
+#define MAX_COLA_CLIENTE 64
+// Operaciones que gana cada solicitante por turno si no se da -d
+#define QUANTUM_DEFECTO 4
+
+// Tramas de un solicitante que esperan ser atendidas, en el orden en que llegaron, con su balde de
+// fichas (una ficha por operación, se recarga a tasa por segundo hasta rafaga) y su déficit
+struct ColaCliente {
+    int pid;
+    int ocupada; // 0 si la casilla está libre
+    char *tramas[MAX_COLA_CLIENTE];
+    int costos[MAX_COLA_CLIENTE]; // Operaciones de cada trama: 1, o n en un lote
+    long long ingresos[MAX_COLA_CLIENTE]; // Instante en que se leyó del pipe
+    int inicio;
+    int cont;
+    double fichas;
+    long long recarga; // Última vez que se recargaron las fichas (ns)
+    int deficit;
+    int enTurno; // 1 si ya recibió el quantum de su turno actual
+};
+
+// Estado del planificador. El hilo lector llena las colas y el hilo principal las vacía
+struct Planificador {
+    pthread_mutex_t mutex;
+    pthread_cond_t hayTramas;
+    struct ColaCliente clientes[MAX_CLIENTES_PLAN];
+    // Anillo con las colas que tienen tramas; turno es la que sigue
+    int activas[MAX_CLIENTES_PLAN];
+    int numActivas;
+    int turno;
+    // Q de algún solicitante: se entrega cuando ya no queda nada en las colas
+    char *salida;
+    long long ingresoSalida;
+    double tasa; // Operaciones por segundo por solicitante, 0 sin límite
+    double rafaga;
+    int quantum;
+    int cerrado;
+};
+
+// Funciones del planificador
+void iniciarPlanificador(double tasa, double rafaga, int quantum);
+int planificadorActivo(void);
+void encolarTrama(const char *trama, int largo, long long tIngreso);
+int siguienteTramaPlanificada(char *trama, int tam, long long *tIngreso);
+void cerrarPlanificador(void);
+void liberarPlanificador(void);
+void *lectorTramas(void *args);
+
+#endif
@@ -0,0 +1,76 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: prestatarios.c
+#	Descripcion: Tabla de qué prestatario tiene cada ejemplar prestado. El préstamo la llena y
+#                la devolución la vacía; la operación L la usa para listar los préstamos de un
+#                prestatario sin recorrer el catálogo.
+#****************************************************************/
+
+#include "prestatarios.h"
+
+// Cubeta de un prestatario
+static unsigned cubetaPrestatario(int prestatario) {
+    return ((unsigned)prestatario * 2654435761u >> 16) % TAM_TABLA_PRESTAMOS;
+}
+
+// Deja la tabla vacía
+void iniciarPrestatarios(struct Prestatarios *t) {
+    for (int k = 0; k < MAX_PRESTAMOS; k++) {
+        t->entradas[k].activo = 0;
+    }
+    for (int k = 0; k < TAM_TABLA_PRESTAMOS; k++) {
+        t->cubetasPrestatario[k] = -1;
+    }
+}
+
+// Registra que el prestatario tiene el ejemplar. Si el ejemplar ya tenía dueño, se reemplaza
+void registrarPrestamo(struct Prestatarios *t, int prestatario, int isbn, int libro, int ejemplar) {
+    if (libro < 0 || libro >= MAX_LIBROS || ejemplar < 0 || ejemplar >= MAX_EJEMPLAR) return;
+    quitarPrestamo(t, libro, ejemplar);
+    int e = libro * MAX_EJEMPLAR + ejemplar;
+    struct Prestamo *p = &t->entradas[e];
+    p->activo = 1;
+    p->prestatario = prestatario;
+    p->isbn = isbn;
+    p->libro = libro;
+    p->ejemplar = ejemplar;
+    unsigned c = cubetaPrestatario(prestatario);
+    p->sigPrestatario = t->cubetasPrestatario[c];
+    t->cubetasPrestatario[c] = e;
+}
+
+// Saca la entrada e de la cadena que empieza en cabeza
+static void desenlazar(struct Prestatarios *t, int *cabeza, int e) {
+    int *enlace = cabeza;
+    while (*enlace != -1 && *enlace != e) {
+        enlace = &t->entradas[*enlace].sigPrestatario;
+    }
+    if (*enlace == e) {
+        *enlace = t->entradas[e].sigPrestatario;
+    }
+}
+
+// Borra el préstamo del ejemplar (devolución). No hace nada si no tenía dueño
+void quitarPrestamo(struct Prestatarios *t, int libro, int ejemplar) {
+    if (libro < 0 || libro >= MAX_LIBROS || ejemplar < 0 || ejemplar >= MAX_EJEMPLAR) return;
+    int e = libro * MAX_EJEMPLAR + ejemplar;
+    struct Prestamo *p = &t->entradas[e];
+    if (!p->activo) return;
+    desenlazar(t, &t->cubetasPrestatario[cubetaPrestatario(p->prestatario)], e);
+    p->activo = 0;
+}
+
+// Copia en prestamos hasta max préstamos del prestatario y devuelve cuántos copió
+int listarPrestamos(const struct Prestatarios *t, int prestatario, struct Prestamo *prestamos, int max) {
+    int n = 0;
+    for (int e = t->cubetasPrestatario[cubetaPrestatario(prestatario)]; e != -1 && n < max; e = t->entradas[e].sigPrestatario) {
+        if (t->entradas[e].prestatario == prestatario) {
+            prestamos[n++] = t->entradas[e];
+        }
+    }
+    return n;
+}
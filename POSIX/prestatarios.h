@@ -0,0 +1,47 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: prestatarios.h
+#	Descripcion: Archivo de encabezado para prestatarios.c.
+#                Define la tabla de préstamos por prestatario usada por la operación L
+#****************************************************************/
+
+#ifndef PRESTATARIOS_H
+#define PRESTATARIOS_H
+
+#include "receptor.h"
+
+#define MAX_PRESTAMOS (MAX_LIBROS * MAX_EJEMPLAR)
+// Potencia de 2; con MAX_PRESTAMOS entradas las cadenas quedan cortas
+#define TAM_TABLA_PRESTAMOS 1024
+
+// Préstamo de un ejemplar a un prestatario. Hay una entrada por ejemplar (posición
+// libro * MAX_EJEMPLAR + ejemplar), porque un ejemplar solo puede tenerlo un prestatario.
+// El prestatario es el cliente del campo s= (el -k del solicitante) o, si la trama no lo trae, el pid
+struct Prestamo {
+    int activo;
+    int prestatario;
+    int isbn;
+    int libro;
+    int ejemplar;
+    int sigPrestatario; // Siguiente entrada en la cubeta del prestatario, -1 si es la última
+};
+
+// Tabla hash encadenada por prestatario para listar sus préstamos. D/R no la consultan: el dueño de
+// cada ejemplar está en el propio ejemplar (ejemplarDe de libbiblioteca).
+// Se protege con mutexLibros, igual que el catálogo
+struct Prestatarios {
+    struct Prestamo entradas[MAX_PRESTAMOS];
+    int cubetasPrestatario[TAM_TABLA_PRESTAMOS];
+};
+
+// Funciones de la tabla de préstamos
+void iniciarPrestatarios(struct Prestatarios *t);
+void registrarPrestamo(struct Prestatarios *t, int prestatario, int isbn, int libro, int ejemplar);
+void quitarPrestamo(struct Prestatarios *t, int libro, int ejemplar);
+int listarPrestamos(const struct Prestatarios *t, int prestatario, struct Prestamo *prestamos, int max);
+
+#endif
@@ -0,0 +1,148 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: protocolo.c
+#	Descripcion: Lectura de las tramas del pipe principal y envío de las respuestas con su secuencia.
+#                Lo comparten el receptor POSIX y el unificado, así los dos hablan el mismo protocolo
+#                con el solicitante: campos r=, b= y s=, respuestas compactas y avisos con s=0.
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <limits.h>
+#include <poll.h>
+#include "protocolo.h"
+#include "respuestas.h"
+#include "grabacion.h"
+#include "bitacora.h"
+
+// Extrae del pipe principal la siguiente trama terminada en '\0'. Varias tramas pueden llegar
+// en un mismo read (clientes concurrentes) y una trama puede llegar partida, por eso lo que
+// sobra se guarda para la siguiente llamada. Solo la usa un hilo: el principal o, con el
+// planificador, el lector de tramas. Si se da vacio, se llama cada vez que el pipe se queda sin
+// datos antes de esperar más. Devuelve el largo de la trama o -1 si no hay datos
+int siguienteTrama(int fd, char *trama, int tam, void (*vacio)(void)) {
+    // Bytes leídos que todavía no forman una trama completa
+    static char pendiente[2 * PIPE_BUF];
+    static int lenPendiente = 0;
+
+    while (1) {
+        //Si ya hay una trama completa se entrega sin volver a leer
+        char *fin = memchr(pendiente, '\0', lenPendiente);
+        if (fin) {
+            int largo = fin - pendiente;
+            int copia = largo < tam - 1 ? largo : tam - 1;
+            memcpy(trama, pendiente, copia);
+            trama[copia] = '\0';
+            lenPendiente -= largo + 1;
+            memmove(pendiente, fin + 1, lenPendiente);
+            //Con -g la trama queda en la grabación tal como llegó
+            grabarTrama(trama, copia);
+            return copia;
+        }
+        //Una trama más larga que el buffer no es válida, se descarta
+        if (lenPendiente == (int)sizeof(pendiente)) {
+            registrar(LOG_AVISO, "Trama demasiado larga descartada");
+            lenPendiente = 0;
+        }
+        //Sin datos listos, quien llama aprovecha antes de quedarse esperando
+        if (vacio) {
+            struct pollfd pfd = {fd, POLLIN, 0};
+            if (poll(&pfd, 1, 0) == 0) vacio();
+        }
+        //Lee los datos del pipe
+        int bytes = read(fd, pendiente + lenPendiente, sizeof(pendiente) - lenPendiente);
+        // No hay datos o fin
+        if (bytes <= 0) {
+            return -1;
+        }
+        lenPendiente += bytes;
+    }
+}
+
+// Lee los campos opcionales "clave=valor" que pueden venir después de los campos fijos de la
+// primera línea: r=1 (reservar si no hay ejemplar), b=id (biblioteca) y s=cliente:sesion:secuencia
+// (identificador para reconocer reenvíos). Las claves desconocidas se ignoran. Sin b= se usa la
+// primera biblioteca; si el nombre no existe queda en -1
+void leerCamposOpcionales(const char *trama, int fijos, struct Operaciones *op) {
+    op->reserva = 0;
+    op->biblioteca = 0;
+    op->cliente = 0;
+    op->sesion = 0;
+    op->secuencia = 0;
+    //El nombre no puede tener comas, así que los opcionales empiezan después de la coma número fijos
+    const char *finLinea = strchr(trama, '\n');
+    if (!finLinea) finLinea = trama + strlen(trama);
+    const char *campo = trama;
+    for (int k = 0; k < fijos && campo; k++) {
+        campo = memchr(campo, ',', finLinea - campo);
+        if (campo) campo++;
+    }
+    while (campo && campo < finLinea) {
+        const char *fin = memchr(campo, ',', finLinea - campo);
+        if (!fin) fin = finLinea;
+        int valor, sesion, secuencia;
+        if (sscanf(campo, "r=%d", &valor) == 1) {
+            op->reserva = valor;
+        } else if (sscanf(campo, "s=%d:%d:%d", &valor, &sesion, &secuencia) == 3) {
+            op->cliente = valor;
+            op->sesion = sesion;
+            op->secuencia = secuencia;
+        } else if (strncmp(campo, "b=", 2) == 0) {
+            op->biblioteca = buscarBiblioteca(campo + 2, fin - campo - 2);
+        }
+        campo = fin < finLinea ? fin + 1 : NULL;
+    }
+}
+
+// Pid del solicitante y operaciones de una trama: "M,n,pid..." cuesta n y "tipo,nombre,isbn,pid..." 1.
+// Las tramas que no traen pid quedan en la cola del pid 0
+int pidDeTrama(const char *trama, int *costo) {
+    int num, pid;
+    *costo = 1;
+    if (trama[0] == 'M') {
+        if (sscanf(trama, "M,%d,%d", &num, &pid) != 2) return 0;
+        *costo = num < 1 ? 1 : num > MAX_LOTE ? MAX_LOTE : num;
+        return pid;
+    }
+    const char *campo = trama;
+    for (int k = 0; k < 3 && campo; k++) {
+        campo = strchr(campo, ',');
+        if (campo) campo++;
+    }
+    return campo ? atoi(campo) : 0;
+}
+
+// Manda la respuesta de una operación. Si la trama traía s=cliente:sesion:secuencia, la respuesta
+// empieza con la línea "s=secuencia" para que el solicitante descarte las de intentos que ya abandonó.
+// Con conTraza la respuesta lleva las marcas de la operación hasta el escritor, que la registra
+void responderSecuencia(struct Operaciones *op, const char *mensaje, int conTraza) {
+    const struct Traza *traza = conTraza ? &op->traza : NULL;
+    if (op->secuencia <= 0) {
+        enviarRespuestaTraza(op->pid, mensaje, traza, op->tipo, op->isbn);
+        return;
+    }
+    char respuesta[MAX_RESPUESTA_LOTE + 16];
+    snprintf(respuesta, sizeof(respuesta), "s=%d\n%s", op->secuencia, mensaje);
+    enviarRespuestaTraza(op->pid, respuesta, traza, op->tipo, op->isbn);
+}
+
+// Manda un aviso de reserva (asignada o cancelada) con la línea MARCA_AVISO delante
+void enviarAviso(int pid, const char *mensaje) {
+    char aviso[sizeof(MARCA_AVISO) + LARGO_COMPACTA];
+    snprintf(aviso, sizeof(aviso), "%s%s", MARCA_AVISO, mensaje);
+    enviarRespuesta(pid, aviso);
+}
+
+
+// Prestatario de una operación: el cliente del campo s= si la trama lo trae y si no el pid. El
+// cliente es el -k del solicitante, así un préstamo se puede devolver, renovar o listar desde otra
+// ejecución; sin s= el préstamo queda atado al proceso que lo pidió
+int prestatarioDe(const struct Operaciones *op) {
+    return op->cliente > 0 ? op->cliente : op->pid;
+}
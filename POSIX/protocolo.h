@@ -0,0 +1,57 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: protocolo.h
+#	Descripcion: Archivo de encabezado para protocolo.c.
+#                Define la operación que llega por el pipe principal y las funciones que leen sus
+#                tramas y contestan con la secuencia, comunes al receptor POSIX y al unificado
+#****************************************************************/
+
+#ifndef PROTOCOLO_H
+#define PROTOCOLO_H
+
+#include <stddef.h>
+#include "traza.h"
+#include "codigos.h"
+
+// Operaciones máximas de un lote M
+#define MAX_LOTE 64
+// Largo máximo de una respuesta (la de un lote es la más larga)
+#define MAX_RESPUESTA_LOTE 8192
+// Nombre de la biblioteca que se usa si la trama no trae b= (y el de la única del receptor unificado)
+#define BIBLIOTECA_DEFECTO "general"
+
+struct Lote;
+
+// Representa una operación enviada por el solicitante
+struct Operaciones {
+    char tipo;
+    char nombre[250];
+    int isbn;
+    int pid;
+    int reserva; // Campo opcional r=1: si no hay ejemplar, el préstamo queda en la lista de espera
+    int biblioteca; // Campo opcional b=id: posición de la biblioteca (-1 si no existe)
+    int cliente; // Campo opcional s=cliente:sesion:secuencia: identifica la operación entre reenvíos
+    int sesion; // Número al azar de cada ejecución del solicitante, así un -k repetido no choca
+    int secuencia; // 0 si la trama no trae s=
+    long long tIngreso; // Instante (ns monotónicos) en que se leyó del pipe
+    long long tEncolado; // Instante en que entró a su carril del buffer
+    int cantidad; // Ejemplares de un alta A
+    struct Lote *lote; // Lote completo de una operación M; lo libera el hilo que lo atiende
+    struct Traza traza; // Marcas de tiempo, solo se llenan con -T
+};
+
+// Funciones del protocolo (protocolo.c)
+int siguienteTrama(int fd, char *trama, int tam, void (*vacio)(void));
+int pidDeTrama(const char *trama, int *costo);
+void leerCamposOpcionales(const char *trama, int fijos, struct Operaciones *op);
+void responderSecuencia(struct Operaciones *op, const char *mensaje, int conTraza);
+void enviarAviso(int pid, const char *mensaje);
+int prestatarioDe(const struct Operaciones *op);
+// La da cada receptor: biblioteca.c en el POSIX y receptor.c en el unificado
+int buscarBiblioteca(const char *id, size_t largo);
+
+#endif
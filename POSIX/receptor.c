@@ -15,291 +15,400 @@
 #include <string.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <signal.h>
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <errno.h>
+#include <limits.h>
 #include "receptor.h"
+#include "biblioteca.h"
+#include "metricas.h"
+#include "bitacora.h"
+#include "administracion.h"
+#include "planificador.h"
+#include "respuestas.h"
+#include "afinidad.h"
+#include "grabacion.h"
+#include "duplicados.h"
 
-// Variables globales para el buffer y los mutex
-struct Operaciones buffer[BUFFER_TAM];
-// Contador de cuantas operaciones hay en el buffer
-int bufferCont = 0;
-pthread_mutex_t mutex;
-pthread_cond_t cond_no_lleno = PTHREAD_COND_INITIALIZER;
-pthread_cond_t cond_no_vacio = PTHREAD_COND_INITIALIZER;
+// El buffer, los mutex, los índices y las tablas de cada catálogo viven en su struct Biblioteca
 // Se usa para saber cuando se terminan los hilos
 int terminar = 0;
 
+// Pasa a la bitácora los mensajes de la carga del catálogo
+static void informeCarga(int aviso, const char *mensaje) {
+    registrar(aviso ? LOG_AVISO : LOG_INFO, "%s", mensaje);
+}
+
 // Función que lee la base de datos de libros desde un archivo de texto y la carga en memoria
 int leerDB(char *nomArchivo, struct Libros *libros) {
-    // Se abre el archivo en modo lectura y se verifica que se haya creado correctamente
-    FILE *archivo = fopen(nomArchivo, "r");
-    if (!archivo) {
+    int cont = cargarLibros(nomArchivo, libros, MAX_LIBROS, informeCarga);
+    // Se verifica que el archivo se haya podido abrir
+    if (cont < 0) {
         printf("Error al abrir el archivo %s\n", nomArchivo);
         exit(1);
     }
-
-    //Char que contendrá la linea leída
-    char linea[256];
-    //Contador de libros leídos
-    int cont = 0;
-    // While que va hasta que no lea mas líneas en el archivo o sobrepase el máximo de libros
-    while (fgets(linea, sizeof(linea), archivo) && cont < MAX_LIBROS) {
-        //Ignorar líneas vacias
-        if (linea[0] == '\n' || linea[0] == '\0') continue;
-        // Elimina el salto de línea
-        linea[strcspn(linea, "\n")] = 0;
-        // Salta a la siguiente iteración si es inválido
-        if (sscanf(linea, "%249[^,],%d,%d", libros[cont].nombre, &libros[cont].isbn, &libros[cont].numEj) == 3) {
-            if (libros[cont].numEj <= 0 || libros[cont].numEj > MAX_EJEMPLAR) {
-                printf("Número de ejemplares inválido para ISBN %d: %d\n", libros[cont].isbn, libros[cont].numEj);
-                continue;
-            }
-            printf("Libro leído: %s, ISBN: %d, NumEj: %d\n", libros[cont].nombre, libros[cont].isbn, libros[cont].numEj);
-            //Leer ejemplares de libros
-            for (int i = 0; i < libros[cont].numEj && fgets(linea, sizeof(linea), archivo); i++) {
-                // Elimina salto de línea
-                linea[strcspn(linea, "\n")] = 0;
-                //Se guarda en un puntero para hacer los cambios con mayor comodidad
-                struct Ejemplar *e = &libros[cont].ejemplares[i];
-                //Char para guardar de  manera efectiva la fecha del ejemplar
-                char fecha_str[11];
-                //Verifica que la fecha tenga el formato válido y las guarda por separado en un entero, para luego guardarla
-                //juntas en ejemplar
-                if (sscanf(linea, "%d%*c%*c%c%*c%10[^,]", &e->numero, &e->status, fecha_str) == 3) {
-                    int dia, mes, anio;
-                    if (sscanf(fecha_str, "%d-%d-%d", &dia, &mes, &anio) == 3) {
-                        snprintf(e->fecha, sizeof(e->fecha), "%02d-%02d-%04d", dia, mes, anio);
-                        printf("Ejemplar leído: Num: %d, Status: %c, Fecha: %s\n", e->numero, e->status, e->fecha);
-                    } else {
-                        //error en caso de formato inválido
-                        printf("Error al parsear la fecha: %s\n", fecha_str);
-                        snprintf(e->fecha, sizeof(e->fecha), "01-01-2000");
-                    }
-                } else {
-                    printf("Error con la línea de ejemplar: %s\n", linea);
-                    continue;
-                }
-            }
-            // Incrementa contador de libros
-            cont++;
-        }
-    }
-    //Cierra el archivo
-    fclose(archivo);
     return cont;
 }
 
-//Añade una operación al buffer compartido, esperando si está lleno
-void anadirBuffer(struct Operaciones *op) {
+// Carril del buffer que le toca a cada tipo de operación
+static int carrilDe(char tipo) {
+    if (tipo == 'D' || tipo == 'R') return CARRIL_DEVOLUCION;
+    if (tipo == 'A') return CARRIL_ADMIN;
+    return CARRIL_PRESTAMO;
+}
+
+//Añade una operación al final de su carril en el buffer de la biblioteca, esperando si está lleno.
+//Con control de admisión (marcaAlta > 0) un P, D, R o lote no espera: si su carril llegó a la marca
+//devuelve 0 y quien llama responde que está ocupado, así una ráfaga no detiene al hilo principal. Las
+//altas, que no vienen del pipe principal, siempre esperan. Devuelve 1 si la operación quedó en el buffer
+int anadirBuffer(struct Biblioteca *bib, struct Operaciones *op) {
+    struct Carril *carril = &bib->carriles[carrilDe(op->tipo)];
     // Bloquea el mutex para acceso exclusivo al buffer
-    pthread_mutex_lock(&mutex);
-    // Espera si el buffer está lleno y manda la señal de esperar en caso de que lo este
-    while (bufferCont >= BUFFER_TAM) {
-        pthread_cond_wait(&cond_no_lleno, &mutex);
+    pthread_mutex_lock(&bib->mutex);
+    if (bib->marcaAlta > 0 && op->tipo != 'A' && carril->cont >= bib->marcaAlta) {
+        pthread_mutex_unlock(&bib->mutex);
+        return 0;
     }
-    // Añade la operación y aumenta el contador
-    buffer[bufferCont++] = *op;
+    // Espera si el carril está lleno
+    while (carril->cont >= bib->bufferTam) {
+        pthread_cond_wait(&bib->cond_no_lleno, &bib->mutex);
+    }
+    // Añade la operación al final del carril y aumenta los contadores
+    struct Operaciones *nueva = &carril->ops[(carril->inicio + carril->cont) % bib->bufferTam];
+    *nueva = *op;
+    nueva->tEncolado = tiempoNs();
+    MARCAR_TRAZA(&nueva->traza, TRAZA_ENCOLADO);
+    carril->cont++;
+    bib->bufferCont++;
+    registrarProfundidad(bib->bufferCont);
     // Notifica que hay datos disponibles
-    pthread_cond_signal(&cond_no_vacio);
+    pthread_cond_signal(&bib->cond_no_vacio);
     //Libera el mutex
-    pthread_mutex_unlock(&mutex);
+    pthread_mutex_unlock(&bib->mutex);
+    return 1;
 }
-//Lee y elimina una operación del buffer compartido, esperando si está vacío
-struct Operaciones leerBuffer() {
-    // Bloquea el mutex para acceso exclusivo al buffer
-    pthread_mutex_lock(&mutex);
-    // Espera en caso de que el buffer este vacio, evitando cualquier problema
-    while (bufferCont == 0 && !terminar) {
-        pthread_cond_wait(&cond_no_vacio, &mutex);
-    }
-
-    // Libera el mutex si no hay más datos
-    if (bufferCont == 0) {
-        pthread_mutex_unlock(&mutex);
-        struct Operaciones op = {'Q', "", 0, 0};
-        return op;
-    }
-    // Extrae operaciones de forma LIFO
-    struct Operaciones op = buffer[--bufferCont];
-    //Da la señal de que no está lleno el buffer
-    pthread_cond_signal(&cond_no_lleno);
-    //Libera el mutex
-    pthread_mutex_unlock(&mutex);
-    return op;
+
+// Responde a un P, D, R o lote que no entró al buffer que el receptor está ocupado y cuánto esperar
+// antes de reintentar. Al lote se le responde con esa sola línea, y el solicitante lo reenvía completo: lo que tardarían los hilos de la biblioteca en atender las operaciones hasta la
+// marca, según su tiempo medio por operación
+void rechazarOcupado(struct Biblioteca *bib, struct Operaciones *op) {
+    long espera = atomic_load(&bib->servicioUs) * bib->marcaAlta / bib->numHilos / 1000;
+    if (espera < MIN_REINTENTO_MS) espera = MIN_REINTENTO_MS;
+    if (espera > MAX_REINTENTO_MS) espera = MAX_REINTENTO_MS;
+    char respuesta[LARGO_COMPACTA + 1];
+    armarRespuesta(respuesta, RESP_OCUPADO, 0, espera, 0, 0);
+    atomic_fetch_add(&operacionesRechazadas, 1);
+    //No se aplicó, así que su reenvío no es un duplicado
+    olvidarDuplicado(op);
+    responderSecuencia(op, respuesta, 0);
 }
 
-// Envía una respuesta al solicitante a través de un pipe nombrado específico
-void enviarRespuesta(int pid, const char *mensaje) {
-    //Char que guardara la respuesta
-    char pipe2[20];
-    // Construye el nombre del pipe a partir del pid mandado en la operación
-    snprintf(pipe2, sizeof(pipe2), "pipe_%d", pid);
-    int fd = -1, intentos = 5;
-
-        //Da 5 intentos al pipe para abrirse
-    while (intentos-- > 0) {
-        // Intenta abrir el pipe de respuesta
-        fd = open(pipe2, O_WRONLY);
-        // Sale del bucle si se abre con éxito
-        if (fd >= 0) { 
-            break;
-        }
-        usleep(100000); // Espera para reintentar
+// Elige el carril que atiende el siguiente hilo con un reparto ponderado suave: cada carril con
+// operaciones suma su peso al crédito, gana el de más crédito y se le descuenta el total sumado.
+// Con pesos 4:2:1 salen cuatro devoluciones por cada dos préstamos y un alta, intercaladas. El
+// carril de altas se salta mientras otra alta se está aplicando. Devuelve -1 si no hay a quién atender
+static int elegirCarril(struct Biblioteca *bib) {
+    int total = 0, elegido = -1;
+    for (int c = 0; c < NUM_CARRILES; c++) {
+        struct Carril *carril = &bib->carriles[c];
+        if (carril->cont == 0 || (c == CARRIL_ADMIN && bib->adminEnCurso)) continue;
+        carril->credito += carril->peso;
+        total += carril->peso;
+        if (elegido < 0 || carril->credito > bib->carriles[elegido].credito) elegido = c;
     }
+    if (elegido >= 0) bib->carriles[elegido].credito -= total;
+    return elegido;
+}
 
-    // Muestra error si no se abre
-    if (fd < 0) {
-        printf("No se pudo abrir el pipe %s\n", pipe2);
-        return;
+//Lee y elimina la operación más antigua del carril que toca, esperando si no hay ninguna.
+//Al terminar, los hilos sacan lo que quede y después reciben una Q
+struct Operaciones leerBuffer(struct Biblioteca *bib) {
+    // Bloquea el mutex para acceso exclusivo al buffer
+    pthread_mutex_lock(&bib->mutex);
+    int c;
+    // Espera en caso de que no haya nada que atender, evitando cualquier problema
+    while ((c = elegirCarril(bib)) < 0) {
+        // Libera el mutex si no hay más datos
+        if (terminar && bib->bufferCont == 0) {
+            pthread_mutex_unlock(&bib->mutex);
+            struct Operaciones op = {'Q', "", 0, 0};
+            return op;
+        }
+        pthread_cond_wait(&bib->cond_no_vacio, &bib->mutex);
     }
+    // Extrae operaciones de forma FIFO dentro del carril
+    struct Carril *carril = &bib->carriles[c];
+    struct Operaciones op = carril->ops[carril->inicio];
+    carril->inicio = (carril->inicio + 1) % bib->bufferTam;
+    carril->cont--;
+    bib->bufferCont--;
+    if (c == CARRIL_ADMIN) bib->adminEnCurso = 1;
+    registrarEspera(c, op.tEncolado);
+    MARCAR_TRAZA(&op.traza, TRAZA_DESENCOLADO);
+    //Da la señal de que hay espacio; puede haber quien espere en otro carril
+    pthread_cond_broadcast(&bib->cond_no_lleno);
+    //Libera el mutex
+    pthread_mutex_unlock(&bib->mutex);
+    return op;
+}
 
-    // Escrube el mensaje en el pipe y manda error en caso de no poder enviarlo
-    if (write(fd, mensaje, strlen(mensaje) + 1) == -1) {
-        printf("Error al escribir en el pipe %s\n", pipe2);
+// Marca que terminó el alta en curso para que otro hilo pueda tomar la siguiente
+static void terminarAlta(struct Biblioteca *bib) {
+    pthread_mutex_lock(&bib->mutex);
+    bib->adminEnCurso = 0;
+    pthread_cond_broadcast(&bib->cond_no_vacio);
+    pthread_mutex_unlock(&bib->mutex);
+}
+
+// Marca que hay que terminar y despierta a los hilos que esperan en el buffer de cada biblioteca.
+// terminar se cambia con el mutex de cada buffer tomado para que ningún hilo se pierda el aviso
+void avisarTerminacion(void) {
+    terminar = 1;
+    for (int b = 0; b < numBibliotecas; b++) {
+        pthread_mutex_lock(&bibliotecas[b].mutex);
+        terminar = 1;
+        pthread_cond_broadcast(&bibliotecas[b].cond_no_vacio);
+        pthread_mutex_unlock(&bibliotecas[b].mutex);
     }
+    //Con el planificador el hilo principal espera en sus colas y no en el pipe
+    cerrarPlanificador();
+}
 
-    close(fd);
+// Responde una operación ya procesada y registra su resultado en las métricas. La traza la
+// registra el escritor cuando la respuesta queda escrita en el pipe. Si la operación está en la
+// ventana de duplicados, su respuesta queda guardada para los reenvíos
+void responder(struct Operaciones *op, const char *mensaje, int exito) {
+    MARCAR_TRAZA(&op->traza, TRAZA_PROCESADO);
+    guardarRespuestaDuplicado(op, mensaje);
+    registrarOperacion(op->tipo, exito, op->tIngreso);
+    marcarRespuesta(&op->traza);
+    responderSecuencia(op, mensaje, 1);
 }
 
-// Lee una operación enviada por el solicitante a través del pipe principal
-int leerPipe(int fd, struct Operaciones *op, int verbose) {
-    //Char que guardara la respuesta
-    char buffer[256];
-    //Lee los datos del pipe
-    int bytes = read(fd, buffer, sizeof(buffer) - 1);
-    // No hay datos o fin 
-    if (bytes <= 0) {
+// Valida un lote: "M,n,pid[,b=id][,s=cliente:sesion:0]" seguido de n líneas "tipo,nombre,isbn" separadas por '\n'
+static int leerLote(char *trama, struct Lote *lote) {
+    int num;
+    if (sscanf(trama, "M,%d,%d", &num, &lote->pid) != 2 || num < 1 || num > MAX_LOTE) {
         return 0;
-    } 
+    }
+    //Los campos opcionales del encabezado empiezan en la tercera coma de la primera línea
+    struct Operaciones encabezado;
+    leerCamposOpcionales(trama, 3, &encabezado);
+    lote->biblioteca = encabezado.biblioteca;
+    lote->num = 0;
+    //El cliente del encabezado es el prestatario de todas las operaciones; los lotes no llevan secuencia
+    char *linea = strchr(trama, '\n');
+    while (linea && lote->num < num) {
+        linea++;
+        struct Operaciones *op = &lote->ops[lote->num];
+        if (sscanf(linea, "%c,%249[^,],%d", &op->tipo, op->nombre, &op->isbn) != 3) {
+            return 0;
+        }
+        op->pid = lote->pid;
+        op->reserva = 0;
+        op->biblioteca = lote->biblioteca;
+        op->cliente = encabezado.cliente;
+        op->sesion = encabezado.sesion;
+        op->secuencia = 0;
+        op->tIngreso = lote->tIngreso;
+        lote->num++;
+        linea = strchr(linea, '\n');
+    }
+    return lote->num == num;
+}
 
-    buffer[bytes] = '\0';
+// Lee una operación enviada por el solicitante a través del pipe principal.
+// Devuelve 1 para D/R, 2 para P, 3 para un lote (en lote), 4 para B, 5 para C, 6 para L, -1 si la trama es inválida y 0 al terminar
+int leerPipe(int fd, struct Operaciones *op, struct Lote *lote, int verbose) {
+    //Char que guardara la trama
+    char buffer[2 * PIPE_BUF];
+    //Con el planificador la trama sale de la cola de su solicitante, con el instante en que se leyó del pipe
+    if (planificadorActivo()) {
+        if (siguienteTramaPlanificada(buffer, sizeof(buffer), &op->tIngreso) < 0) {
+            return 0;
+        }
+    } else {
+        if (siguienteTrama(fd, buffer, sizeof(buffer), NULL) < 0) {
+            return 0;
+        }
+        op->tIngreso = tiempoNs();
+    }
+    marcarIngreso(&op->traza, op->tIngreso);
+
+    //Los lotes traen varias operaciones de un mismo solicitante
+    if (buffer[0] == 'M') {
+        lote->tIngreso = op->tIngreso;
+        lote->traza = op->traza;
+        if (!leerLote(buffer, lote)) {
+            registrar(LOG_AVISO, "Lote inválido recibido: %.60s", buffer);
+            return -1;
+        }
+        //Si la biblioteca no existe se contesta el error en cada línea del lote
+        if (lote->biblioteca < 0) {
+            char respuesta[MAX_RESPUESTA_LOTE];
+            int largo = snprintf(respuesta, sizeof(respuesta), "M,%d", lote->num);
+            for (int k = 0; k < lote->num; k++) {
+                respuesta[largo++] = '\n';
+                largo += armarRespuesta(respuesta + largo, RESP_ERROR_BIBLIOTECA, 0, 0, 0, 0);
+            }
+            enviarRespuesta(lote->pid, respuesta);
+            registrar(LOG_AVISO, "Lote para una biblioteca inexistente, pid %d", lote->pid);
+            return -1;
+        }
+        MARCAR_TRAZA(&lote->traza, TRAZA_PARSEADO);
+        if (verbose) {
+            registrar(LOG_INFO, "Recibido: lote de %d operaciones, pid = %d", lote->num, lote->pid);
+        }
+        return 3;
+    }
 
         //Valida el formato en el que se recibió la operación
     if (sscanf(buffer, "%c,%249[^,],%d,%d", &op->tipo, op->nombre, &op->isbn, &op->pid) != 4) {
-        printf("Formato inválido recibido: %s\n", buffer);
-        return 0;
+        registrar(LOG_AVISO, "Formato inválido recibido: %s", buffer);
+        return -1;
     }
+    leerCamposOpcionales(buffer, 4, op);
+    MARCAR_TRAZA(&op->traza, TRAZA_PARSEADO);
 
     //Se imprime lo que se recibió en caso de haber activado verbose
     if (verbose) {
-        printf("Recibido: tipo = %c, nombre = %s, isbn = %d, pid = %d\n", op->tipo, op->nombre, op->isbn, op->pid);
+        registrar(LOG_INFO, "Recibido: tipo = %c, nombre = %s, isbn = %d, pid = %d", op->tipo, op->nombre, op->isbn, op->pid);
     }
 
-    // Se añade al buffer y se marca para terminar los hilos en caso de ser Q
+    // Se marca para terminar los hilos de todas las bibliotecas en caso de ser Q
     if (op->tipo == 'Q') {
-        anadirBuffer(op);
-        terminar = 1;
+        registrarOperacion('Q', 1, op->tIngreso);
+        avisarTerminacion();
         return 0;
+    }
+    //Las demás operaciones necesitan una biblioteca válida
+    if (op->biblioteca < 0) {
+        char respuesta[LARGO_COMPACTA + 1];
+        armarRespuesta(respuesta, RESP_ERROR_BIBLIOTECA, 0, 0, 0, 0);
+        responder(op, respuesta, 0);
+        return -1;
         // Se retorna 1 en caso de ser devolución o renovación
     } else if (op->tipo == 'D' || op->tipo == 'R') {
         return 1;
         //Se retorna 2 en caso de ser préstamo
     } else if (op->tipo == 'P') {
         return 2;
+        //Se retorna 4 en caso de ser búsqueda (nombre trae los términos e isbn la página)
+    } else if (op->tipo == 'B') {
+        return 4;
+        //Se retorna 5 en caso de ser consulta de disponibilidad
+    } else if (op->tipo == 'C') {
+        return 5;
+        //Se retorna 6 en caso de pedir la lista de préstamos del solicitante
+    } else if (op->tipo == 'L') {
+        return 6;
+        //Las altas solo se aceptan por el pipe de administración, que solo puede abrir el dueño del receptor
+    } else if (op->tipo == 'A') {
+        responder(op, "Error: Las altas solo se aceptan por el pipe de administración", 0);
+        return -1;
     }
 
-    return 0;
+    return -1;
+}
+
+// Aplica una devolución o renovación sobre el catálogo y deja la respuesta compacta.
+// Se usa el ejemplar que el solicitante tiene registrado en la tabla de préstamos; si no tiene
+// ninguno, se toma el primer ejemplar prestado que no está a nombre de nadie (préstamos que ya
+// venían en la base de datos). Así nunca se devuelve ni renueva el ejemplar de otro solicitante.
+// Si el libro tiene lista de espera, el ejemplar devuelto pasa directo al primero y se deja el aviso
+// para él en aviso (pid 0 si no hay). Debe llamarse con mutexLibros tomado. Devuelve 1 si tuvo éxito
+int aplicarDevolucion(struct Biblioteca *bib, struct Operaciones *op, char *respuesta, struct Aviso *aviso) {
+    struct Catalogo *cat = catalogoActual(bib);
+    aviso->pid = 0;
+    //Se busca el libro con el isbn y el nombre de la operación
+    int i = buscarLibro(cat->libros, cat->numLibros, op->isbn, op->nombre);
+    //Condicional en caso de no encontrar un libro válido, se envía mensaje de error
+    if (i < 0) {
+        armarRespuesta(respuesta, RESP_ERROR_NO_ENCONTRADO, op->isbn, 0, 0, 0);
+        registrar(LOG_AVISO, "ISBN %d no encontrado", op->isbn);
+        return 0;
+    }
+    struct Libros *libro = &cat->libros[i];
+    //Se busca el ejemplar del solicitante y si no tiene, uno prestado sin dueño conocido
+    int j = ejemplarDe(libro, prestatarioDe(op));
+    //Condicional en caso de no encontrar el ejemplar, se envía mensaje de error
+    if (j < 0) {
+        armarRespuesta(respuesta, RESP_ERROR_SIN_PRESTAMO, op->isbn, 0, 0, 0);
+        registrar(LOG_AVISO, "No se encontró un ejemplar prestado para ISBN %d, prestatario %d", op->isbn, prestatarioDe(op));
+        return 0;
+    }
+    marcarCambio(cat, i);
+    // Condicional en caso de que el tipo de la op sea devolución
+    if (op->tipo == 'D') {
+        devolverEjemplar(libro, j);
+        quitarVencimiento(&cat->vencimientos, i, j);
+        quitarPrestamo(&cat->prestatarios, i, j);
+        asignarReserva(bib, i, j, aviso);
+        actualizarResumen(cat, i);
+        //Se notifica en pantalla
+        registrar(LOG_INFO, "Devolución realizada del libro: ISBN %d, Ejemplar %d", op->isbn, libro->ejemplares[j].numero);
+        armarRespuesta(respuesta, RESP_DEVOLUCION, op->isbn, libro->ejemplares[j].numero, 0, 0);
+        return 1;
+    }
+    //Si no, es renovación: se guarda el cambio en la fecha del ejemplar
+    renovarEjemplar(libro, j);
+    programarVencimiento(&cat->vencimientos, i, j, diaFecha(libro->ejemplares[j].fecha));
+    actualizarResumen(cat, i);
+    registrar(LOG_INFO, "Renovación procesada: ISBN %d, Ejemplar %d, Nueva fecha: %s", op->isbn, libro->ejemplares[j].numero, libro->ejemplares[j].fecha);
+    armarRespuesta(respuesta, RESP_RENOVACION, op->isbn, libro->ejemplares[j].numero, fechaCompacta(libro->ejemplares[j].fecha), 0);
+    return 1;
 }
 
-// Procesa las operaciones de devolución y renovación que esten en el buffer
+// Atiende los carriles del buffer de una biblioteca: devoluciones y renovaciones, préstamos, lotes y altas
 void *auxiliar1(void *args) {
-    // Se leen los argumentos pasados desde la creación del hilo
-    struct Libros *libros = (struct Libros *)((void **)args)[0];
-    int numLibros = *(int *)((void **)args)[1];
+    // Se lee la biblioteca pasada desde la creación del hilo
+    struct Biblioteca *bib = (struct Biblioteca *)args;
 
     //While que no tiene condición, se detiene si se usa un break
     while (1) {
     //Se lee una operación del buffer
-        struct Operaciones op = leerBuffer();
+        struct Operaciones op = leerBuffer(bib);
         //Si el tipo es q, se sale del while
         if (op.tipo == 'Q') {
             break;
         }
-        //Ciclo que recorre el el número de libros que hay en la base de datos
-        for (int i = 0; i < numLibros; i++) {
-            //Se verifica si el isbn y el nombre de libro de la operación es el mismo al libro actual
-            if (libros[i].isbn == op.isbn && strcmp(libros[i].nombre, op.nombre) == 0) {
-                // entero que sirve para saber si se encontro el ejemplar buscado
-                int encontrado = 0;
-                // Ciclo que recorre los ejemplares del libro encontrado
-                for (int j = 0; j < libros[i].numEj; j++) {
-                    // Se pregunta si el status del libro es prestado
-                    if (libros[i].ejemplares[j].status == 'P' && !encontrado) {
-                        // Condicional en caso de que el tipo de la op sea devolución
-                        if (op.tipo == 'D') {
-                            //Se cambia el status a devuelto
-                            libros[i].ejemplares[j].status = 'D';
-                            //Se notifica en pantalla
-                            printf("Devolución realizada del libro: ISBN %d, Ejemplar %d\n", op.isbn, libros[i].ejemplares[j].numero);
-                            //Se envía la respuesta al proceso solicitante y se marca como encontrado el libro
-                            char respuesta[256];
-                            snprintf(respuesta, sizeof(respuesta), "Devolución exitosa: ISBN %d, Ejemplar %d", op.isbn, libros[i].ejemplares[j].numero);
-                            enviarRespuesta(op.pid, respuesta);
-                            encontrado = 1;
-                            break;
-                            //Condicional en caso de que el tipo de la op sea renovar
-                        } else if (op.tipo == 'R') {
-                            // Se guarda las fechas en variables distintas para asegurar correctamente el cambio de fecha
-                            char dia[3], mes[3], anio[5];
-                            sscanf(libros[i].ejemplares[j].fecha, "%2s-%2s-%4s", dia, mes, anio);
-                            int d = atoi(dia);
-                            //se añaden 7 días
-                            d += 7;
-                            //Si días resulta mayor a 30 se resta 30 a los días
-                            if (d > 30) {
-                                d -= 30;
-                                //aumenta el mes, si es mayor a 12 se vuelve el primer mes del año
-                                int m = atoi(mes);
-                                m++;
-                                if (m < 1 || m > 12) {
-                                    m = 1;
-                                }
-                                snprintf(mes, sizeof(mes), "%02d", m);
-                            }
-                            if (d < 1 || d > 30) d = 1; // Corrige en caso de aun haber un día inválido
-                            // Se cmambia el día de entero a char
-                            snprintf(dia, sizeof(dia), "%02d", d);
-                            dia[2] = '\0';
-                            mes[2] = '\0';
-                            anio[4] = '\0';
-                            //Se guarda el cambio en la fecha del ejemplar y se manda la respuesta al proceso solicitante
-                            snprintf(libros[i].ejemplares[j].fecha, 11, "%2s-%2s-%4s", dia, mes, anio);
-                            printf("Renovación procesada: ISBN %d, Ejemplar %d, Nueva fecha: %s\n", op.isbn, libros[i].ejemplares[j].numero, libros[i].ejemplares[j].fecha);
-                            char respuesta[256];
-                            snprintf(respuesta, sizeof(respuesta), "Renovación exitosa: ISBN %d, Ejemplar %d", op.isbn, libros[i].ejemplares[j].numero);
-                            enviarRespuesta(op.pid, respuesta);
-                            encontrado = 1;
-                            break;
-                        }
-                    }
-                }
-                //Condicional en caso de no encontrar el ejemplar, se envía mensaje de error
-                if (!encontrado) {
-                    char respuesta[256];
-                    snprintf(respuesta, sizeof(respuesta), "Error: No se encontró un ejemplar prestado para ISBN %d", op.isbn);
-                    enviarRespuesta(op.pid, respuesta);
-                    printf("No se encontró un ejemplar prestado para ISBN %d\n", op.isbn);
-                }
-                break;
+        //Las altas no cuentan en el tiempo medio: esperan a los lectores y escriben el archivo
+        if (op.tipo == 'A') {
+            altaProceso(bib, &op);
+            terminarAlta(bib);
+            continue;
+        }
+        long long inicio = tiempoNs();
+        if (op.tipo == 'P') {
+            prestamoProceso(bib, &op);
+        } else if (op.tipo == 'M') {
+            procesarLote(bib, op.lote);
+            free(op.lote);
+        } else {
+            //Se aplica con el catálogo bloqueado y se responde después de liberarlo
+            char respuesta[LARGO_COMPACTA + 1];
+            struct Aviso aviso;
+            pthread_mutex_lock(&bib->mutexLibros);
+            int exito = aplicarDevolucion(bib, &op, respuesta, &aviso);
+            pthread_mutex_unlock(&bib->mutexLibros);
+            responder(&op, respuesta, exito);
+            //Si el ejemplar se asignó a una reserva, se le avisa a ese solicitante
+            if (aviso.pid) {
+                enviarAviso(aviso.pid, aviso.mensaje);
             }
-            //Condicional en caso de no encontrar un libro válidp, se envía mensaje de error
-            if (i == numLibros - 1) {
-                char respuesta[256];
-                snprintf(respuesta, sizeof(respuesta), "Error: ISBN %d no encontrado o nombre erróneo", op.isbn);
-                enviarRespuesta(op.pid, respuesta);
-                printf("ISBN %d no encontrado\n", op.isbn);
-            } 
         }
+        //Promedio móvil del tiempo por operación (peso 1/8 a la última), para sugerir esperas al rechazar
+        long medido = (tiempoNs() - inicio) / 1000;
+        long promedio = atomic_load(&bib->servicioUs);
+        atomic_store(&bib->servicioUs, promedio + (medido - promedio) / 8);
     }
     return NULL;
 }
 
-//Maneja comandos interactivos del usuario (s para salir, r para generar reporte)
+//Maneja comandos interactivos del usuario (s para salir, r para generar reporte, m para métricas,
+//o para vencidos, c para recargar los catálogos)
 void *auxiliar2(void *args) {
-    // Se leen los argumentos pasados desde la creación del hilo
-    struct Libros *libros = (struct Libros *)((void **)args)[0];
-    int numLibros = *(int *)((void **)args)[1];
     //Se guarda el comando en este char
     char comando[3];
 
@@ -308,158 +417,519 @@ void *auxiliar2(void *args) {
         //Se válida que no se use mas de un caracter en los comandos
         if (scanf("%2s", comando) != 1) {
             while (getchar() != '\n'); // Limpia el buffer de entrada
-            printf("Entrada inválida, utilice 's' para salir o 'r' para reporte\n");
+            printf("Entrada inválida, utilice 's' para salir, 'r' para reporte, 'm' para métricas, 'o' para vencidos o 'c' para recargar\n");
             continue;
         }
         //// Limpia el buffer después de leer
         while (getchar() != '\n');
         //En caso de que se pida salir
         if (strcmp(comando, "s") == 0) {
-            // Bloquea el mutex para modificar terminar
-            pthread_mutex_lock(&mutex);
-            //se marca para terminar los hilos
-            terminar = 1;
-            //Libera el mutex
-            pthread_mutex_unlock(&mutex);
-            // Notifica a otros hilos
-            pthread_cond_broadcast(&cond_no_vacio);
+            //se marca para terminar los hilos y se les notifica en todas las bibliotecas
+            avisarTerminacion();
             break;
             //En caso de que el comando sea de reporte
         } else if (strcmp(comando, "r") == 0) {
             printf("Reporte:\n");
-            // Bloquea para acceso seguro a libros
-            pthread_mutex_lock(&mutex);
-            //Se imprimen los ejemplares
-            for (int i = 0; i < numLibros; i++) {
-                for (int j = 0; j < libros[i].numEj; j++) {
-                    printf("%c, %s, %d, %d, %s\n", libros[i].ejemplares[j].status, libros[i].nombre, libros[i].isbn, libros[i].ejemplares[j].numero, libros[i].ejemplares[j].fecha);
+            // Se copia el estado con el catálogo bloqueado y se imprime después de liberarlo,
+            // así la consola no detiene a los hilos que usan el buffer
+            struct Libros *copia = malloc(sizeof(struct Libros) * MAX_LIBROS);
+            if (!copia) {
+                printf("Error al reservar memoria para el reporte\n");
+                continue;
+            }
+            for (int b = 0; b < numBibliotecas; b++) {
+                struct Biblioteca *bib = &bibliotecas[b];
+                pthread_mutex_lock(&bib->mutexLibros);
+                struct Catalogo *cat = catalogoActual(bib);
+                int numLibros = cat->numLibros;
+                memcpy(copia, cat->libros, sizeof(struct Libros) * numLibros);
+                pthread_mutex_unlock(&bib->mutexLibros);
+                //Con varias bibliotecas se separa el reporte de cada una
+                if (numBibliotecas > 1) {
+                    printf("Biblioteca %s:\n", bib->id);
                 }
+                //Se imprimen los ejemplares
+                imprimirLibros(stdout, copia, numLibros);
+            }
+            free(copia);
+            //En caso de que se pidan las métricas, se leen sin bloquear a los demás hilos
+        } else if (strcmp(comando, "m") == 0) {
+            imprimirMetricas(stdout);
+            //En caso de que se pidan los préstamos vencidos, se copian del montículo y se imprimen sin el mutex
+        } else if (strcmp(comando, "o") == 0) {
+            for (int b = 0; b < numBibliotecas; b++) {
+                imprimirVencidos(&bibliotecas[b]);
             }
-            pthread_mutex_unlock(&mutex);
+            //En caso de pedir la recarga, se hace lo mismo que con SIGHUP
+        } else if (strcmp(comando, "c") == 0) {
+            kill(getpid(), SIGHUP);
         } else {
-            //Verificacion en caso de no ser r o s lo que se digita
-            printf("Utilice solo 's' o 'r' si quiere acabar la ejecución o ver un reporte\n");
+            //Verificacion en caso de no ser r, m, o, c o s lo que se digita
+            printf("Utilice solo 's', 'r', 'm', 'o' o 'c' si quiere acabar la ejecución, ver un reporte, ver las métricas, ver los vencidos o recargar los catálogos\n");
         }
     }
     return NULL;
 }
 
-// Procesa una operación de préstamo, actualizando el estado de un ejemplar disponible.
-void prestamoProceso(struct Operaciones *op, struct Libros *libros, int numLibros) {
-    //Para validar de que se encuentre el libro
-    int libroEncontrado = 0;
-    //Ciclo que recorre los libros
-    for (int i = 0; i < numLibros; i++) {
-        //Se verifica si el isbn y el nombre de libro de la operación es el mismo al libro actual
-        if (libros[i].isbn == op->isbn && strcmp(libros[i].nombre, op->nombre) == 0) {
-            //Marca que encontro el libro y hay otra validación por si se encontró ejemplar que no este prestado
-            libroEncontrado = 1;
-            int encontrado = 0;
-            //Ciclo que recorre todos los ejemplares del libro
-            for (int j = 0; j < libros[i].numEj; j++) {
-                //Si encuentra uno no prestado, cambia el status a prestado y aumenta la fecha, de igual manera que en las renovaciones
-                if (libros[i].ejemplares[j].status == 'D') {
-                    libros[i].ejemplares[j].status = 'P';
-                    char dia[3], mes[3], anio[5];
-                    sscanf(libros[i].ejemplares[j].fecha, "%2s-%2s-%4s", dia, mes, anio);
-                    int d = atoi(dia);
-                    d += 7;
-                    if (d > 30) {
-                        d -= 30;
-                        int m = atoi(mes);
-                        m++;
-                        if (m < 1 || m > 12) m = 1;
-                        snprintf(mes, sizeof(mes), "%02d", m);
-                    }
-                    if (d < 1 || d > 30) d = 1;
-                    snprintf(dia, sizeof(dia), "%02d", d);
-                    dia[2] = '\0';
-                    mes[2] = '\0';
-                    anio[4] = '\0';
-                    snprintf(libros[i].ejemplares[j].fecha, 11, "%2s-%2s-%4s", dia, mes, anio);
-                    //Avisa que se realizó el préstamo y envia respuesta al proceso solicitante
-                    printf("Préstamo realizado del libro: ISBN %d, Ejemplar %d\n", op->isbn, libros[i].ejemplares[j].numero);
-                    char respuesta[256];
-                    snprintf(respuesta, sizeof(respuesta), "Préstamo exitoso: ISBN %d, Ejemplar %d", op->isbn, libros[i].ejemplares[j].numero);
-                    enviarRespuesta(op->pid, respuesta);
-                    encontrado = 1;
-                    return;
-                }
+// Imprime los préstamos vencidos a la fecha de hoy. Se copian del montículo con el catálogo
+// bloqueado (O(k) para k vencidos) y se imprimen después de liberarlo; la lectura por épocas
+// mantiene vivo ese catálogo aunque una recarga lo cambie mientras se imprime
+void imprimirVencidos(struct Biblioteca *bib) {
+    struct Vencimiento *vencidos = malloc(sizeof(struct Vencimiento) * MAX_VENCIMIENTOS);
+    if (!vencidos) {
+        printf("Error al reservar memoria para los vencidos\n");
+        return;
+    }
+    leerCatalogo(bib);
+    pthread_mutex_lock(&bib->mutexLibros);
+    struct Catalogo *cat = catalogoActual(bib);
+    struct Libros *libros = cat->libros;
+    int n = listarVencidos(&cat->vencimientos, diaHoy(), vencidos, MAX_VENCIMIENTOS);
+    pthread_mutex_unlock(&bib->mutexLibros);
+    if (numBibliotecas > 1) {
+        printf("Biblioteca %s, préstamos vencidos: %d\n", bib->id, n);
+    } else {
+        printf("Préstamos vencidos: %d\n", n);
+    }
+    for (int k = 0; k < n; k++) {
+        char fecha[11];
+        fechaDia(vencidos[k].dia, fecha);
+        printf("%s, %d, %d, %s\n", libros[vencidos[k].libro].nombre, libros[vencidos[k].libro].isbn,
+               libros[vencidos[k].libro].ejemplares[vencidos[k].ejemplar].numero, fecha);
+    }
+    soltarCatalogo();
+    free(vencidos);
+}
+
+// Revisa cada cierto tiempo los préstamos vencidos y deja un recordatorio en la bitácora por cada
+// uno que no se haya avisado todavía. Una renovación vuelve a habilitar el aviso
+void *recordatorios(void *args) {
+    int intervalo = *(int *)args;
+    struct Vencimiento *vencidos = malloc(sizeof(struct Vencimiento) * MAX_VENCIMIENTOS);
+    if (!vencidos) {
+        registrar(LOG_ERROR, "No se pudo reservar memoria para los recordatorios");
+        return NULL;
+    }
+    while (!terminar) {
+        for (int b = 0; b < numBibliotecas; b++) {
+            struct Biblioteca *bib = &bibliotecas[b];
+            leerCatalogo(bib);
+            pthread_mutex_lock(&bib->mutexLibros);
+            struct Catalogo *cat = catalogoActual(bib);
+            int n = listarVencidos(&cat->vencimientos, diaHoy(), vencidos, MAX_VENCIMIENTOS);
+            int nuevos = 0;
+            for (int k = 0; k < n; k++) {
+                if (vencidos[k].avisado) continue;
+                marcarAvisado(&cat->vencimientos, vencidos[k].libro, vencidos[k].ejemplar);
+                marcarCambio(cat, vencidos[k].libro);
+                vencidos[nuevos++] = vencidos[k];
             }
-            //Si no encontro ejemplar manda mensaje de error
-            if (!encontrado) {
-                char respuesta[256];
-                snprintf(respuesta, sizeof(respuesta), "Error: No se encontró un ejemplar disponible para ISBN %d", op->isbn);
-                enviarRespuesta(op->pid, respuesta);
-                printf("No se encontró un ejemplar disponible para ISBN %d\n", op->isbn);
+            pthread_mutex_unlock(&bib->mutexLibros);
+            for (int k = 0; k < nuevos; k++) {
+                char fecha[11];
+                fechaDia(vencidos[k].dia, fecha);
+                registrar(LOG_AVISO, "Préstamo vencido en %s: ISBN %d, Ejemplar %d, entrega %s", bib->id, cat->libros[vencidos[k].libro].isbn,
+                          cat->libros[vencidos[k].libro].ejemplares[vencidos[k].ejemplar].numero, fecha);
             }
-            return;
+            soltarCatalogo();
+        }
+        //Se duerme en pasos cortos para notar rápido que hay que terminar
+        for (int t = 0; t < intervalo * 10 && !terminar; t++) {
+            usleep(100000);
         }
     }
-    //Si no encontro libro válido, manda mensaje de error
-    if (!libroEncontrado) {
-        char respuesta[256];
-        snprintf(respuesta, sizeof(respuesta), "Error: ISBN %d no encontrado o nombre erróneo", op->isbn);
-        enviarRespuesta(op->pid, respuesta);
-        printf("ISBN %d no encontrado\n", op->isbn);
+    free(vencidos);
+    return NULL;
+}
+
+// Aplica un préstamo sobre el catálogo, actualizando el estado de un ejemplar disponible, y deja
+// la respuesta compacta. Debe llamarse con mutexLibros tomado. Devuelve 1 si tuvo éxito
+int aplicarPrestamo(struct Biblioteca *bib, struct Operaciones *op, char *respuesta) {
+    struct Catalogo *cat = catalogoActual(bib);
+    //Se busca el libro con el isbn y el nombre de la operación
+    int i = buscarLibro(cat->libros, cat->numLibros, op->isbn, op->nombre);
+    //Si no encontro libro válido, deja mensaje de error
+    if (i < 0) {
+        armarRespuesta(respuesta, RESP_ERROR_NO_ENCONTRADO, op->isbn, 0, 0, 0);
+        registrar(LOG_AVISO, "ISBN %d no encontrado", op->isbn);
+        return 0;
+    }
+    struct Libros *libro = &cat->libros[i];
+    //Se presta el primer ejemplar disponible, con la fecha de entrega corrida como en las renovaciones
+    int j = prestarEjemplar(libro, prestatarioDe(op));
+    if (j >= 0) {
+        programarVencimiento(&cat->vencimientos, i, j, diaFecha(libro->ejemplares[j].fecha));
+        registrarPrestamo(&cat->prestatarios, prestatarioDe(op), op->isbn, i, j);
+        marcarCambio(cat, i);
+        actualizarResumen(cat, i);
+        //Avisa que se realizó el préstamo y deja la respuesta para el proceso solicitante
+        registrar(LOG_INFO, "Préstamo realizado del libro: ISBN %d, Ejemplar %d", op->isbn, libro->ejemplares[j].numero);
+        armarRespuesta(respuesta, RESP_PRESTAMO, op->isbn, libro->ejemplares[j].numero, fechaCompacta(libro->ejemplares[j].fecha), 0);
+        return 1;
+    }
+    //Si no hay ejemplar y el solicitante pidió reserva, queda en la lista de espera
+    if (op->reserva) {
+        return encolarReserva(bib, op, i, respuesta);
     }
+    //Si no encontro ejemplar deja mensaje de error
+    armarRespuesta(respuesta, RESP_ERROR_SIN_EJEMPLAR, op->isbn, 0, 0, 0);
+    registrar(LOG_AVISO, "No se encontró un ejemplar disponible para ISBN %d", op->isbn);
+    return 0;
 }
 
-// Guarda el estado final de la base de datos en un archivo de salida
-void guardarSalida(char *fileSalida, struct Libros *libros, int numLibros) {
-    //Abre el archivo en modo escritura
-    FILE *salida = fopen(fileSalida, "w");
-    //si hay error se le notifica al usuario
-    if (!salida) {
-        printf("Error al crear el archivo de salida\n");
-        return;
+// Recalcula el resumen de disponibilidad de un libro y lo publica con una sola escritura atómica.
+// Se llama al cargar y, con mutexLibros tomado, después de cada cambio en sus ejemplares
+void actualizarResumen(struct Catalogo *cat, int i) {
+    struct Libros *libros = cat->libros;
+    unsigned long long disponibles = 0, prestados = 0, entrega = 0;
+    for (int j = 0; j < libros[i].numEj; j++) {
+        if (libros[i].ejemplares[j].status != 'P') {
+            disponibles++;
+            continue;
+        }
+        prestados++;
+        // La fecha dd-mm-aaaa se pasa a aaaammdd para poder compararla como entero
+        unsigned long long fecha = fechaCompacta(libros[i].ejemplares[j].fecha);
+        if (fecha && (entrega == 0 || fecha < entrega)) entrega = fecha;
     }
-    // Guarda todos los libros y ejemplares en el archivo con el mismo formato de la base de datos
-    for (int i = 0; i < numLibros; i++) {
-        fprintf(salida, "%s,%d,%d\n", libros[i].nombre, libros[i].isbn, libros[i].numEj);
-        for (int j = 0; j < libros[i].numEj; j++) {
-            fprintf(salida, "%d,%c,%s\n", libros[i].ejemplares[j].numero, libros[i].ejemplares[j].status, libros[i].ejemplares[j].fecha);
+    atomic_store_explicit(&cat->resumenLibros[i], disponibles | prestados << 16 | entrega << 32, memory_order_release);
+}
+
+// Agrega al solicitante a la lista de espera del libro i y deja la respuesta de en espera con su
+// posición. Debe llamarse con mutexLibros tomado. Devuelve 0 si la lista está llena o ya estaba en ella
+int encolarReserva(struct Biblioteca *bib, struct Operaciones *op, int i, char *respuesta) {
+    struct ListaEspera *lista = &catalogoActual(bib)->esperas[i];
+    int prestatario = prestatarioDe(op);
+    for (int k = 0; k < lista->cont; k++) {
+        if (lista->prestatarios[(lista->inicio + k) % MAX_ESPERA] == prestatario) {
+            armarRespuesta(respuesta, RESP_ERROR_YA_RESERVADO, op->isbn, 0, 0, 0);
+            return 0;
         }
     }
-    //Se cierra el archivo
-    fclose(salida);
+    if (lista->cont == MAX_ESPERA) {
+        armarRespuesta(respuesta, RESP_ERROR_LISTA_LLENA, op->isbn, 0, 0, 0);
+        registrar(LOG_AVISO, "Lista de espera llena para ISBN %d", op->isbn);
+        return 0;
+    }
+    lista->pids[(lista->inicio + lista->cont) % MAX_ESPERA] = op->pid;
+    lista->prestatarios[(lista->inicio + lista->cont) % MAX_ESPERA] = prestatario;
+    lista->cont++;
+    marcarCambio(catalogoActual(bib), i);
+    atomic_fetch_add(&reservasEnEspera, 1);
+    registrar(LOG_INFO, "Reserva en espera: ISBN %d, pid %d, posición %d", op->isbn, op->pid, lista->cont);
+    armarRespuesta(respuesta, RESP_EN_ESPERA, op->isbn, lista->cont, 0, 0);
+    return 1;
+}
+
+// Si el libro i tiene reservas, presta el ejemplar j (recién devuelto) al primero de la lista
+// y deja el aviso para él. Debe llamarse con mutexLibros tomado
+void asignarReserva(struct Biblioteca *bib, int i, int j, struct Aviso *aviso) {
+    struct Catalogo *cat = catalogoActual(bib);
+    struct Libros *libros = cat->libros;
+    struct ListaEspera *lista = &cat->esperas[i];
+    if (lista->cont == 0) return;
+    aviso->pid = lista->pids[lista->inicio];
+    int prestatario = lista->prestatarios[lista->inicio];
+    lista->inicio = (lista->inicio + 1) % MAX_ESPERA;
+    lista->cont--;
+    atomic_fetch_sub(&reservasEnEspera, 1);
+    atomic_fetch_add(&reservasAsignadas, 1);
+
+    libros[i].ejemplares[j].status = 'P';
+    libros[i].ejemplares[j].prestatario = prestatario;
+    extenderFecha(libros[i].ejemplares[j].fecha);
+    programarVencimiento(&cat->vencimientos, i, j, diaFecha(libros[i].ejemplares[j].fecha));
+    registrarPrestamo(&cat->prestatarios, prestatario, libros[i].isbn, i, j);
+    registrar(LOG_INFO, "Reserva asignada: ISBN %d, Ejemplar %d, pid %d, prestatario %d", libros[i].isbn, libros[i].ejemplares[j].numero, aviso->pid, prestatario);
+    armarRespuesta(aviso->mensaje, RESP_RESERVA_ASIGNADA, libros[i].isbn, libros[i].ejemplares[j].numero, fechaCompacta(libros[i].ejemplares[j].fecha), 0);
+}
+
+// Al terminar se avisa a los solicitantes que siguen en espera para que no se queden bloqueados
+void cancelarReservas(struct Biblioteca *bib) {
+    struct Catalogo *cat = catalogoActual(bib);
+    for (int i = 0; i < cat->numLibros; i++) {
+        struct ListaEspera *lista = &cat->esperas[i];
+        char mensaje[LARGO_COMPACTA + 1];
+        armarRespuesta(mensaje, RESP_RESERVA_CANCELADA, cat->libros[i].isbn, 0, 0, 0);
+        while (lista->cont > 0) {
+            enviarAviso(lista->pids[lista->inicio], mensaje);
+            lista->inicio = (lista->inicio + 1) % MAX_ESPERA;
+            lista->cont--;
+            atomic_fetch_sub(&reservasEnEspera, 1);
+        }
+        marcarCambio(cat, i);
+    }
+}
+
+// Responde una consulta de disponibilidad con el resumen del libro. Solo lee la tabla de ISBN y el
+// resumen atómico, así que no toma mutexLibros ni pasa por el buffer. El catálogo lo pasa quien
+// llama: el de leerCatalogo o, dentro de un lote, el vigente con el mutex tomado.
+// Devuelve 1 si el libro existe
+int aplicarConsulta(struct Catalogo *cat, struct Operaciones *op, char *respuesta) {
+    int i = buscarIsbn(&cat->indiceIsbn, op->isbn);
+    if (i < 0) {
+        armarRespuesta(respuesta, RESP_ERROR_ISBN, op->isbn, 0, 0, 0);
+        registrar(LOG_AVISO, "ISBN %d no encontrado", op->isbn);
+        return 0;
+    }
+    unsigned long long resumen = atomic_load_explicit(&cat->resumenLibros[i], memory_order_acquire);
+    armarRespuesta(respuesta, RESP_CONSULTA, op->isbn, RESUMEN_DISPONIBLES(resumen), RESUMEN_PRESTADOS(resumen), RESUMEN_ENTREGA(resumen));
+    return 1;
+}
+
+// Procesa una consulta de disponibilidad y responde al solicitante
+void consultaProceso(struct Biblioteca *bib, struct Operaciones *op) {
+    char respuesta[LARGO_COMPACTA + 1];
+    int exito = aplicarConsulta(leerCatalogo(bib), op, respuesta);
+    soltarCatalogo();
+    responder(op, respuesta, exito);
+}
+
+// Responde con los préstamos que tiene el prestatario. Se copian de la tabla con el catálogo
+// bloqueado y la respuesta se arma después de liberarlo, dentro de una lectura por épocas
+void listarProceso(struct Biblioteca *bib, struct Operaciones *op) {
+    struct Prestamo prestamos[MAX_LISTA_PRESTAMOS];
+    char fechas[MAX_LISTA_PRESTAMOS][11];
+    leerCatalogo(bib);
+    pthread_mutex_lock(&bib->mutexLibros);
+    struct Catalogo *cat = catalogoActual(bib);
+    struct Libros *libros = cat->libros;
+    int n = listarPrestamos(&cat->prestatarios, prestatarioDe(op), prestamos, MAX_LISTA_PRESTAMOS);
+    for (int k = 0; k < n; k++) {
+        memcpy(fechas[k], libros[prestamos[k].libro].ejemplares[prestamos[k].ejemplar].fecha, 11);
+    }
+    pthread_mutex_unlock(&bib->mutexLibros);
+
+    char respuesta[MAX_RESPUESTA_LOTE];
+    int largo = snprintf(respuesta, sizeof(respuesta), "Préstamos del solicitante %d: %d", prestatarioDe(op), n);
+    for (int k = 0; k < n && largo < (int)sizeof(respuesta); k++) {
+        struct Libros *libro = &libros[prestamos[k].libro];
+        largo += snprintf(respuesta + largo, sizeof(respuesta) - largo, "\nISBN %d, Ejemplar %d, entrega %s: %s",
+                          libro->isbn, libro->ejemplares[prestamos[k].ejemplar].numero, fechas[k], libro->nombre);
+    }
+    soltarCatalogo();
+    responder(op, respuesta, 1);
+}
+
+// Procesa una operación de préstamo y responde al solicitante
+void prestamoProceso(struct Biblioteca *bib, struct Operaciones *op) {
+    char respuesta[LARGO_COMPACTA + 1];
+    pthread_mutex_lock(&bib->mutexLibros);
+    int exito = aplicarPrestamo(bib, op, respuesta);
+    pthread_mutex_unlock(&bib->mutexLibros);
+    responder(op, respuesta, exito);
+}
+
+// Procesa un lote completo con una sola toma del catálogo y responde con una sola trama
+// "M,n" seguida de una línea compacta por operación, en el mismo orden del lote
+void procesarLote(struct Biblioteca *bib, struct Lote *lote) {
+    char respuesta[MAX_RESPUESTA_LOTE];
+    int exitos[MAX_LOTE];
+    struct Aviso avisos[MAX_LOTE];
+    int largo = snprintf(respuesta, sizeof(respuesta), "M,%d", lote->num);
+
+    pthread_mutex_lock(&bib->mutexLibros);
+    for (int k = 0; k < lote->num; k++) {
+        struct Operaciones *op = &lote->ops[k];
+        //Cada línea se arma directo en la respuesta, después de su '\n'
+        char *linea = respuesta + largo + 1;
+        respuesta[largo] = '\n';
+        avisos[k].pid = 0;
+        if (op->tipo == 'P') {
+            exitos[k] = aplicarPrestamo(bib, op, linea);
+        } else if (op->tipo == 'D' || op->tipo == 'R') {
+            exitos[k] = aplicarDevolucion(bib, op, linea, &avisos[k]);
+        } else if (op->tipo == 'C') {
+            exitos[k] = aplicarConsulta(catalogoActual(bib), op, linea);
+        } else {
+            exitos[k] = 0;
+            armarRespuesta(linea, RESP_ERROR_EN_LOTE, 0, op->tipo, 0, 0);
+        }
+        largo += 1 + LARGO_COMPACTA;
+    }
+    pthread_mutex_unlock(&bib->mutexLibros);
+
+    MARCAR_TRAZA(&lote->traza, TRAZA_PROCESADO);
+    marcarRespuesta(&lote->traza);
+    enviarRespuestaTraza(lote->pid, respuesta, &lote->traza, 'M', lote->num);
+    for (int k = 0; k < lote->num; k++) {
+        registrarOperacion(lote->ops[k].tipo, exitos[k], lote->tIngreso);
+        if (avisos[k].pid) {
+            enviarAviso(avisos[k].pid, avisos[k].mensaje);
+        }
+    }
+}
+
+// Atiende una búsqueda de títulos con el índice invertido. Los términos vienen en nombre y la
+// página (desde 1) en isbn. No toca el catálogo mutable, así que no toma mutexLibros; la lectura
+// por épocas evita que una recarga libere el índice mientras se usa
+void busquedaProceso(struct Biblioteca *bib, struct Operaciones *op) {
+    int pagina = op->isbn > 0 ? op->isbn : 1;
+    //Una página cuya posición no cabe en un int se rechaza antes de calcularla
+    if (pagina > INT_MAX / TAM_PAGINA) {
+        char error[96];
+        snprintf(error, sizeof(error), "Error: página %d fuera de rango (máximo %d)", pagina, INT_MAX / TAM_PAGINA);
+        responder(op, error, 0);
+        return;
+    }
+    int resultados[TAM_PAGINA];
+    struct Catalogo *cat = leerCatalogo(bib);
+    int total = buscarTitulos(&cat->indiceTitulos, op->nombre, (pagina - 1) * TAM_PAGINA, resultados, TAM_PAGINA);
+    int paginas = (total + TAM_PAGINA - 1) / TAM_PAGINA;
+
+    char respuesta[MAX_RESPUESTA_LOTE];
+    int largo = snprintf(respuesta, sizeof(respuesta), "Resultados para \"%s\": %d (página %d de %d)", op->nombre, total, pagina, paginas);
+    for (int k = 0; k < TAM_PAGINA && (pagina - 1) * TAM_PAGINA + k < total && largo < (int)sizeof(respuesta); k++) {
+        struct Libros *libro = &cat->libros[resultados[k]];
+        largo += snprintf(respuesta + largo, sizeof(respuesta) - largo, "\nISBN %d: %s", libro->isbn, libro->nombre);
+    }
+    soltarCatalogo();
+    responder(op, respuesta, total > 0);
+}
+
+// Guarda el estado final de la base de datos en un archivo de salida. Devuelve 0 si no se pudo escribir
+int guardarSalida(char *fileSalida, struct Libros *libros, int numLibros) {
+    //Se guardan todos los libros y ejemplares con el mismo formato de la base de datos
+    if (!guardarLibros(fileSalida, libros, numLibros)) {
+        //si hay error se le notifica al usuario
+        printf("Error al crear el archivo de salida\n");
+        return 0;
+    }
+    return 1;
 }
 
 
 // Proceso principal. Inicializa los recursos, crea hilos, y procesa operaciones
 int main(int argc, char *argv[]) {
     //Se verifica que se pase la cantidad de argumentos válida, de lo contrario se sale del programa
-    if (argc != 5 && argc != 6 && argc != 7 && argc != 8) {
-        printf("\n \t\tUse: $./receptor –p pipeReceptor –f filedatos [-v] [–s filesalida]\n");
+    if (argc < 5 || argc > 32 + 2 * MAX_BIBLIOTECAS) {
+        printf("\n \t\tUse: $./receptor –p pipeReceptor –f [id=]filedatos [–f id=filedatos ...] [-v] [–s filesalida] [-e filestats] [-T filetraza] [-a segundos] [-w hilos] [-q capacidad] [-H marca] [-t tasa[:rafaga]] [-d quantum] [-W pesoD:pesoP:pesoA] [-R escritores] [-j us[:bytes]] [-A pipeAdmin] [-C rol=cpus[:rol=cpus...]] [-g filegrabacion]\n");
         exit(1);
     }
 
     //Variables por si toca guardar datos según lo que se pase de argumento
     char *pipeRec = NULL;
-    char *nomArchivo = NULL;
     int verbose = 0;
     char *fileSalida = NULL;
-    //Arreglo de libros
-    struct Libros libros[MAX_LIBROS];
+    char *fileStats = NULL;
+    char *fileTraza = NULL;
+    int intervaloAvisos = 0;
+    int hilosPorBiblioteca = 1;
+    int capacidadBuffer = BUFFER_TAM;
+    int marcaAlta = 0;
+    double tasaCliente = 0, rafagaCliente = 0;
+    int quantum = 0;
+    int pesos[NUM_CARRILES] = {PESO_DEVOLUCION_DEFECTO, PESO_PRESTAMO_DEFECTO, PESO_ADMIN_DEFECTO};
+    int numEscritores = ESCRITORES_DEFECTO;
+    int esperaAgrupar = ESPERA_AGRUPAR_DEFECTO_US, bytesAgrupar = PIPE_BUF;
+    char *pipeAdmin = NULL;
+    char *fileGrabacion = NULL;
 
         //Recorre los argumentos y revisa que banderas hay y cuales no, guardando la información respectiva
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
             pipeRec = argv[++i];
         } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
-            nomArchivo = argv[++i];
+            //Cada -f agrega una biblioteca con su propio catálogo
+            if (!agregarBiblioteca(argv[++i])) {
+                exit(1);
+            }
         } else if (strcmp(argv[i], "-v") == 0) {
             verbose = 1;
         } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
             fileSalida = argv[++i];
+        } else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+            fileStats = argv[++i];
+        } else if (strcmp(argv[i], "-T") == 0 && i + 1 < argc) {
+            fileTraza = argv[++i];
+        } else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
+            intervaloAvisos = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            hilosPorBiblioteca = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-q") == 0 && i + 1 < argc) {
+            capacidadBuffer = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-H") == 0 && i + 1 < argc) {
+            marcaAlta = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            //tasa[:rafaga] en operaciones por segundo por solicitante; sin rafaga se permite un segundo de tasa
+            char *dosPuntos = strchr(argv[++i], ':');
+            tasaCliente = atof(argv[i]);
+            rafagaCliente = dosPuntos ? atof(dosPuntos + 1) : tasaCliente;
+        } else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc) {
+            quantum = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-W") == 0 && i + 1 < argc) {
+            //Pesos de los carriles de devoluciones, préstamos y altas
+            if (sscanf(argv[++i], "%d:%d:%d", &pesos[CARRIL_DEVOLUCION], &pesos[CARRIL_PRESTAMO], &pesos[CARRIL_ADMIN]) != 3) {
+                pesos[CARRIL_DEVOLUCION] = 0;
+            }
+        } else if (strcmp(argv[i], "-R") == 0 && i + 1 < argc) {
+            numEscritores = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            //us[:bytes]: cuánto puede esperar una respuesta para juntarse con otras del mismo solicitante
+            char *dosPuntos = strchr(argv[++i], ':');
+            esperaAgrupar = atoi(argv[i]);
+            bytesAgrupar = dosPuntos ? atoi(dosPuntos + 1) : PIPE_BUF;
+        } else if (strcmp(argv[i], "-A") == 0 && i + 1 < argc) {
+            pipeAdmin = argv[++i];
+        } else if ((strcmp(argv[i], "-C") == 0 || strcmp(argv[i], "--cpus") == 0) && i + 1 < argc) {
+            //CPUs de cada rol de hilos: ingreso, trabajo, escritura y consola
+            if (!leerTopologia(argv[++i])) {
+                printf("Error: -C necesita rol=cpus[:rol=cpus...] con roles ingreso, trabajo, escritura o consola y CPUs existentes (ej. 0,2-3)\n");
+                exit(1);
+            }
+        } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            fileGrabacion = argv[++i];
         }
     }
 
-    //Se cierra el programa en caso de no haber ni nombre de pipe ni nombre del archivo de la base de datos
-    if (!pipeRec || !nomArchivo) {
-        printf("\n \t\tUse: $./receptor –p pipeReceptor –f filedatos [-v] [–s filesalida]\n");
+    //Se cierra el programa en caso de no haber ni nombre de pipe ni ninguna base de datos
+    if (!pipeRec || numBibliotecas == 0) {
+        printf("\n \t\tUse: $./receptor –p pipeReceptor –f [id=]filedatos [–f id=filedatos ...] [-v] [–s filesalida] [-e filestats] [-T filetraza] [-a segundos] [-w hilos] [-q capacidad] [-H marca] [-t tasa[:rafaga]] [-d quantum] [-W pesoD:pesoP:pesoA] [-R escritores] [-j us[:bytes]] [-A pipeAdmin] [-C rol=cpus[:rol=cpus...]] [-g filegrabacion]\n");
+        exit(1);
+    }
+    if (hilosPorBiblioteca < 1 || hilosPorBiblioteca > MAX_HILOS_BIBLIOTECA) {
+        printf("Error: -w debe estar entre 1 y %d\n", MAX_HILOS_BIBLIOTECA);
+        exit(1);
+    }
+    if (capacidadBuffer < 1 || capacidadBuffer > MAX_BUFFER_TAM) {
+        printf("Error: -q debe estar entre 1 y %d\n", MAX_BUFFER_TAM);
+        exit(1);
+    }
+    if (tasaCliente < 0 || rafagaCliente < 0 || (tasaCliente > 0 && rafagaCliente < 1) || quantum < 0 || quantum > MAX_LOTE) {
+        printf("Error: -t necesita una tasa y una ráfaga de al menos 1 y -d debe estar entre 1 y %d\n", MAX_LOTE);
+        exit(1);
+    }
+    for (int c = 0; c < NUM_CARRILES; c++) {
+        if (pesos[c] < 1 || pesos[c] > MAX_PESO_CARRIL) {
+            printf("Error: -W necesita tres pesos entre 1 y %d (devoluciones:prestamos:altas)\n", MAX_PESO_CARRIL);
+            exit(1);
+        }
+    }
+    if (numEscritores < 1 || numEscritores > MAX_ESCRITORES) {
+        printf("Error: -R debe estar entre 1 y %d\n", MAX_ESCRITORES);
+        exit(1);
+    }
+    if (esperaAgrupar < 0 || esperaAgrupar > MAX_ESPERA_AGRUPAR_US || bytesAgrupar < 1 || bytesAgrupar > PIPE_BUF) {
+        printf("Error: -j necesita una espera de 0 a %d us y de 1 a %d bytes\n", MAX_ESPERA_AGRUPAR_US, PIPE_BUF);
+        exit(1);
+    }
+    if (marcaAlta < 0 || marcaAlta > capacidadBuffer) {
+        printf("Error: -H debe estar entre 1 y la capacidad del buffer (%d)\n", capacidadBuffer);
         exit(1);
     }
+    // Con -g cada trama del pipe principal se guarda con su instante para repetirla con replay
+    if (fileGrabacion && !iniciarGrabacion(fileGrabacion)) {
+        printf("Error al crear el archivo de grabación %s\n", fileGrabacion);
+        exit(1);
+    }
+
+    // SIGHUP se bloquea antes de crear cualquier hilo; solo el hilo de recarga la recibe con sigwait
+    sigset_t senales;
+    sigemptyset(&senales);
+    sigaddset(&senales, SIGHUP);
+    pthread_sigmask(SIG_BLOCK, &senales, NULL);
+    // Si un solicitante cierra su pipe a mitad de una respuesta el escritor recibe EPIPE en lugar de terminar el proceso
+    signal(SIGPIPE, SIG_IGN);
 
     // Se verifica que el pipe se haya creado con éxito y no exista desde antes
     if (mkfifo(pipeRec, 0666) == -1 && errno != EEXIST) {
@@ -472,54 +942,216 @@ int main(int argc, char *argv[]) {
         printf("Error al abrir el pipe %s\n", pipeRec);
         exit(1);
     }
-    // Se lee la base de datos y se verifica que se haya leído exitosamente
-    int numLibros = leerDB(nomArchivo, libros);
-    if (numLibros <= 0 || numLibros > MAX_LIBROS) {
-        printf("Error cargando la base de datos\n");
+    // Con -A las altas de libros y ejemplares llegan por un pipe que solo el dueño del receptor puede abrir
+    int fdAdmin = -1;
+    if (pipeAdmin && (fdAdmin = abrirPipeAdmin(pipeAdmin)) < 0) {
+        close(fd);
+        unlink(pipeRec);
+        exit(1);
+    }
+    // Con -T cada operación guarda sus marcas de tiempo para exportarlas al final
+    if (fileTraza) {
+        iniciarTraza();
+    }
+    // Los mensajes de operación pasan por la bitácora asíncrona desde aquí
+    iniciarBitacora(stdout, LOG_INFO);
+    // Las respuestas las escriben hilos aparte, así ningún hilo que procesa operaciones espera a un pipe
+    if (!iniciarEscritores(numEscritores, esperaAgrupar, bytesAgrupar)) {
+        detenerBitacora();
+        printf("Error al crear los hilos escritores de respuestas\n");
         close(fd);
         unlink(pipeRec);
+        if (pipeAdmin) unlink(pipeAdmin);
         exit(1);
     }
+    // Se lee la base de datos de cada biblioteca y se verifica que se haya leído exitosamente
+    for (int b = 0; b < numBibliotecas; b++) {
+        if (!iniciarBiblioteca(&bibliotecas[b], capacidadBuffer, marcaAlta, pesos)) {
+            detenerEscritores();
+            detenerBitacora();
+            printf("Error cargando la base de datos %s\n", bibliotecas[b].archivo);
+            close(fd);
+            unlink(pipeRec);
+            if (pipeAdmin) unlink(pipeAdmin);
+            exit(1);
+        }
+    }
 
-    //Se inicializa el mutex, se asigna memoria para los libros y se crea args para llevarlo a los métodos de los hilos
-    pthread_mutex_init(&mutex, NULL);
-    pthread_t hiloAux1, hiloAux2;
-    void *args[2] = {libros, &numLibros};
+    pthread_t hiloAux2, hiloMetricas, hiloAvisos, hiloRecarga, hiloAdmin, hiloLector;
 
-    // Se crean los hilos
-    pthread_create(&hiloAux1, NULL, auxiliar1, args);
-    pthread_create(&hiloAux2, NULL, auxiliar2, args);
+    // Se crean los hilos que atienden los carriles de cada biblioteca y el de la consola
+    // Con -C cada hilo se fija a una CPU de su rol apenas se crea
+    for (int b = 0; b < numBibliotecas; b++) {
+        bibliotecas[b].numHilos = hilosPorBiblioteca;
+        for (int h = 0; h < hilosPorBiblioteca; h++) {
+            pthread_create(&bibliotecas[b].hilos[h], NULL, auxiliar1, &bibliotecas[b]);
+            char nombre[32];
+            snprintf(nombre, sizeof(nombre), "auxiliar1 %.16s/%d", bibliotecas[b].id, h);
+            fijarHilo(ROL_TRABAJO, bibliotecas[b].hilos[h], nombre);
+        }
+    }
+    pthread_create(&hiloAux2, NULL, auxiliar2, NULL);
+    fijarHilo(ROL_CONSOLA, hiloAux2, "auxiliar2");
+    // SIGHUP (o el comando c) recarga los catálogos sin detener a los demás hilos
+    pthread_create(&hiloRecarga, NULL, recargador, NULL);
+    fijarHilo(ROL_CONSOLA, hiloRecarga, "recarga");
+    // Con -t o -d un hilo lee el pipe y el principal atiende a los solicitantes por turnos
+    if (tasaCliente > 0 || quantum > 0) {
+        iniciarPlanificador(tasaCliente, rafagaCliente, quantum > 0 ? quantum : QUANTUM_DEFECTO);
+        pthread_create(&hiloLector, NULL, lectorTramas, &fd);
+        fijarHilo(ROL_INGRESO, hiloLector, "lector");
+    }
+    // Las altas del pipe de administración las lee su propio hilo y las deja en el carril de altas
+    if (fdAdmin >= 0) {
+        pthread_create(&hiloAdmin, NULL, administrador, &fdAdmin);
+        fijarHilo(ROL_INGRESO, hiloAdmin, "administracion");
+    }
+    // Si se pidió archivo de estadísticas, un hilo lo reescribe periódicamente
+    if (fileStats) {
+        pthread_create(&hiloMetricas, NULL, escritorMetricas, fileStats);
+        fijarHilo(ROL_CONSOLA, hiloMetricas, "metricas");
+    }
+    // Si se pidió, un hilo revisa cada intervaloAvisos segundos los préstamos que se vencen
+    if (intervaloAvisos > 0) {
+        pthread_create(&hiloAvisos, NULL, recordatorios, &intervaloAvisos);
+        fijarHilo(ROL_CONSOLA, hiloAvisos, "recordatorios");
+    }
+    // El principal se fija al final para que los hilos anteriores no hereden su CPU
+    fijarHilo(ROL_INGRESO, pthread_self(), "principal");
+    imprimirTopologia();
 
         //While encargado de leer el pipe y definir que hacer con lo que se lea
     struct Operaciones op;
+    struct Lote *lote = malloc(sizeof(struct Lote));
     while (!terminar) {
         //Se lee el pipe y se devuelve el resultado, tal y como vimos antes
-        int resultado = leerPipe(fd, &op, verbose);
-        //Si resultado y contador es 0, se notifica a los usuarios y se menciona que ya no hay operaciones a los hilos
-        if (resultado == 0 && bufferCont == 0) {
-            pthread_cond_broadcast(&cond_no_vacio);
+        int resultado = leerPipe(fd, &op, lote, verbose);
+        //Si resultado es 0 ya se avisó a los hilos, que terminan de vaciar sus buffers antes de salir
+        if (resultado == 0) {
             break;
         }
-        //resultado es igual a 1, se añade la operación al buffer
-        if (resultado == 1) { // Operaciones D o R
-            anadirBuffer(&op);
-            //Si es 2, se llama directamente a prestamoProceso para manejar la operación
-        } else if (resultado == 2) { // Operación P
-            prestamoProceso(&op, libros, numLibros);
+        //Si hubo error no hay nada más que hacer con la operación
+        if (resultado < 0) {
+            continue;
+        }
+        //La operación se atiende en la biblioteca que indicó (la primera si no dijo ninguna)
+        struct Biblioteca *bib = &bibliotecas[resultado == 3 ? lote->biblioteca : op.biblioteca];
+        //Si es 1 o 2 (D, R o P), la operación va al final de su carril
+        if (resultado == 1 || resultado == 2) {
+            //Un reenvío de una operación que ya se respondió se contesta con la misma respuesta, y
+            //uno de una que sigue en curso se ignora porque la respuesta del original ya va a llegar
+            char respuesta[LARGO_COMPACTA + 1];
+            int estado = revisarDuplicado(&op, respuesta);
+            //Si la ventana no tiene dónde registrarla se rechaza, así su reenvío no se aplica dos veces
+            if (estado == DUP_LLENA) {
+                rechazarOcupado(bib, &op);
+                continue;
+            }
+            if (estado != DUP_NUEVA) {
+                atomic_fetch_add(&operacionesRepetidas, 1);
+                if (verbose) {
+                    registrar(LOG_INFO, "Reenvío de cliente %d, secuencia %d %s", op.cliente, op.secuencia, estado == DUP_RESPONDIDA ? "respondido de la ventana" : "ignorado (en curso)");
+                }
+                if (estado == DUP_RESPONDIDA) {
+                    responderSecuencia(&op, respuesta, 0);
+                }
+                continue;
+            }
+            //Con control de admisión, si el carril llegó a la marca se responde que reintente
+            if (!anadirBuffer(bib, &op)) {
+                rechazarOcupado(bib, &op);
+            }
+            //Si es 3, el lote completo va al carril de préstamos y se aplica con una sola toma del catálogo
+        } else if (resultado == 3) {
+            struct Operaciones trabajo = {'M', "", 0, lote->pid};
+            trabajo.tIngreso = lote->tIngreso;
+            trabajo.lote = malloc(sizeof(struct Lote));
+            if (!trabajo.lote) {
+                registrar(LOG_ERROR, "No se pudo reservar memoria para un lote de %d", lote->pid);
+                continue;
+            }
+            memcpy(trabajo.lote, lote, sizeof(struct Lote));
+            //Con control de admisión el lote completo se rechaza si su carril llegó a la marca
+            if (!anadirBuffer(bib, &trabajo)) {
+                free(trabajo.lote);
+                rechazarOcupado(bib, &trabajo);
+            }
+            //Si es 4, 5 o 6 la consulta va por el carril rápido: se responde aquí mismo sin cola
+        } else {
+            registrarEspera(CARRIL_CONSULTA, op.tIngreso);
+            if (resultado == 4) {
+                //La búsqueda se responde desde el índice
+                busquedaProceso(bib, &op);
+            } else if (resultado == 5) {
+                //La consulta se responde con el resumen atómico, sin tomar el catálogo
+                consultaProceso(bib, &op);
+            } else {
+                //Se listan los préstamos del solicitante
+                listarProceso(bib, &op);
+            }
         }
     }
+    free(lote);
+    //El lector sigue esperando en el pipe; una trama vacía lo despierta para que vea terminar
+    if (planificadorActivo()) {
+        if (write(fd, "", 1) == -1) {
+            registrar(LOG_ERROR, "No se pudo despertar al lector de tramas");
+        }
+        pthread_join(hiloLector, NULL);
+    }
+    //Ya nadie lee el pipe principal
+    detenerGrabacion();
 
+    //El hilo de administración termina antes que los de las bibliotecas, así ninguna alta queda
+    //en un carril que ya nadie atiende
+    if (fdAdmin >= 0) {
+        despertarAdministrador(fdAdmin);
+        pthread_join(hiloAdmin, NULL);
+        close(fdAdmin);
+        unlink(pipeAdmin);
+    }
     //Se esperan a los hilos a que acabem y se cierra el pipe
-    pthread_join(hiloAux1, NULL);
+    for (int b = 0; b < numBibliotecas; b++) {
+        for (int h = 0; h < hilosPorBiblioteca; h++) {
+            pthread_join(bibliotecas[b].hilos[h], NULL);
+        }
+    }
     pthread_join(hiloAux2, NULL);
+    //El hilo de recarga ve terminar al despertar
+    pthread_kill(hiloRecarga, SIGHUP);
+    pthread_join(hiloRecarga, NULL);
+    if (fileStats) {
+        pthread_join(hiloMetricas, NULL);
+        guardarMetricas(fileStats);
+    }
+    if (intervaloAvisos > 0) {
+        pthread_join(hiloAvisos, NULL);
+    }
     close(fd);
+    //Los que quedaron en lista de espera reciben la cancelación antes de cerrar
+    for (int b = 0; b < numBibliotecas; b++) {
+        cancelarReservas(&bibliotecas[b]);
+    }
+    //Los escritores entregan lo que quede en las colas de salida antes de cerrar la bitácora
+    detenerEscritores();
 
-    //Si se marco que se quiere el archivo de salida, se llama al método respectivo
+    detenerBitacora();
+    if (fileTraza) {
+        guardarTraza(fileTraza);
+    }
+
+    //Si se marco que se quiere el archivo de salida, se guarda uno por biblioteca
     if (fileSalida) {
-        guardarSalida(fileSalida, libros, numLibros);
+        for (int b = 0; b < numBibliotecas; b++) {
+            char nombre[512];
+            nombreSalida(fileSalida, &bibliotecas[b], nombre, sizeof(nombre));
+            struct Catalogo *cat = catalogoActual(&bibliotecas[b]);
+            guardarSalida(nombre, cat->libros, cat->numLibros);
+        }
     }
-    //Se destruye el mutex y se elimina el archivo del pipe
-    pthread_mutex_destroy(&mutex);
+    //Se liberan las bibliotecas y las tramas que no se alcanzaron a atender, y se elimina el archivo del pipe
+    liberarPlanificador();
+    liberarBibliotecas();
     unlink(pipeRec);
     return 0;
 }
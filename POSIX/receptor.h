@@ -12,47 +12,77 @@
 #ifndef RECEPTOR_H
 #define RECEPTOR_H
 
-#define MAX_EJEMPLAR 10
-#define MAX_LIBROS 100
+#include <stddef.h>
+#include <stdatomic.h>
+#include "protocolo.h"
+#include "libbiblioteca.h"
+
+// Capacidad por defecto de cada carril del buffer de una biblioteca y la máxima que se puede pedir con -q
 #define BUFFER_TAM 10
+#define MAX_BUFFER_TAM 1024
+// Límites de la espera sugerida en la respuesta de ocupado
+#define MIN_REINTENTO_MS 1
+#define MAX_REINTENTO_MS 1000
+// Carriles del buffer de cada biblioteca: D y R, P y lotes, y altas A (de a una). Las consultas B, C
+// y L son el carril rápido: las atiende el hilo principal sin cola, solo tienen métricas de espera
+#define CARRIL_DEVOLUCION 0
+#define CARRIL_PRESTAMO 1
+#define CARRIL_ADMIN 2
+#define NUM_CARRILES 3
+#define CARRIL_CONSULTA 3
+#define NUM_CARRILES_METRICAS 4
+// Peso de cada carril en el reparto si no se da -W (devoluciones:prestamos:admin) y el máximo
+#define PESO_DEVOLUCION_DEFECTO 4
+#define PESO_PRESTAMO_DEFECTO 2
+#define PESO_ADMIN_DEFECTO 1
+#define MAX_PESO_CARRIL 64
+#define MAX_ESPERA 16
+#define MAX_LISTA_PRESTAMOS 64
 
-//Representa un ejemplar de un libro con su número, estado y fecha
-struct Ejemplar {
-    int numero;
-    char status;
-    char fecha[11];
+// Cola circular de solicitantes que esperan un ejemplar de un libro: el pid al que se avisa y el
+// prestatario a cuyo nombre queda el préstamo. Se protege con mutexLibros
+struct ListaEspera {
+    int pids[MAX_ESPERA];
+    int prestatarios[MAX_ESPERA];
+    int inicio;
+    int cont;
 };
 
-// Representa un libro con su ISBN, nombre y arreglo de ejemplares
-struct Libros {
-    int isbn;
-    char nombre[250];
-    int numEj;
-    struct Ejemplar ejemplares[MAX_EJEMPLAR];
+// Aviso para un solicitante en espera al que se le asignó un ejemplar. Se arma con el catálogo
+// bloqueado y se manda después de liberarlo
+struct Aviso {
+    int pid;
+    char mensaje[LARGO_COMPACTA + 1];
 };
 
-// Representa una operación enviada por el solicitante
-struct Operaciones {
-    char tipo;
-    char nombre[250];
-    int isbn;
+// Representa un lote de operaciones de un mismo solicitante que se aplican juntas
+struct Lote {
     int pid;
+    int num;
+    int biblioteca;
+    long long tIngreso;
+    struct Traza traza;
+    struct Operaciones ops[MAX_LOTE];
 };
 
+// Resumen de disponibilidad de cada libro para la consulta C (resumenLibros de cada biblioteca):
+// ejemplares disponibles (bits 0-15), prestados (bits 16-31) y la entrega más próxima como aaaammdd
+// (bits 32-63, 0 si no hay préstamos). Va en un solo entero atómico para leerlo sin tomar mutexLibros
+#define RESUMEN_DISPONIBLES(r) ((int)((r) & 0xFFFF))
+#define RESUMEN_PRESTADOS(r) ((int)(((r) >> 16) & 0xFFFF))
+#define RESUMEN_ENTREGA(r) ((int)((r) >> 32))
+
 // Variables compartidas
-extern struct Operaciones buffer[BUFFER_TAM];
-extern int bufferCont;
 extern int terminar;
 
-// Funciones del receptor
+// Funciones del receptor (las que trabajan sobre una biblioteca están en biblioteca.h)
 int leerDB(char *nomArchivo, struct Libros *libros);
-void anadirBuffer(struct Operaciones *op);
-struct Operaciones leerBuffer();
-void enviarRespuesta(int pid, const char *mensaje);
-int leerPipe(int fd, struct Operaciones *op, int verbose);
+void responder(struct Operaciones *op, const char *mensaje, int exito);
+int leerPipe(int fd, struct Operaciones *op, struct Lote *lote, int verbose);
+void avisarTerminacion(void);
 void *auxiliar1(void *args);
 void *auxiliar2(void *args);
-void prestamoProceso(struct Operaciones *op, struct Libros *libros, int numLibros);
-void guardarSalida(char *fileSalida, struct Libros *libros, int numLibros);
+void *recordatorios(void *args);
+int guardarSalida(char *fileSalida, struct Libros *libros, int numLibros);
 
 #endif
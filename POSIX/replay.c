@@ -0,0 +1,264 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: replay.c
+#	Descripcion: Repite contra un receptor (POSIX o unificado) las tramas que otro receptor
+#                grabó con -g, al ritmo grabado, x veces más rápido o sin pausas. Cada solicitante
+#                grabado pasa a ser un solicitante simulado con su propio pipe de respuesta, y al
+#                final se muestra cuánto se atrasó el envío respecto a la grabación.
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "replay.h"
+
+// Solicitantes simulados. Solo el hilo principal los agrega; el lector de respuestas ve numClientes
+static struct ClienteReplay clientes[MAX_CLIENTES_REPLAY];
+static int numClientes = 0;
+static pthread_mutex_t mutexClientes = PTHREAD_MUTEX_INITIALIZER;
+static long respuestas = 0;
+static long long ultimaRespuesta = 0;
+static int terminar = 0;
+
+// Instante actual en nanosegundos monotónicos
+static long long ahoraNs(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (long long)t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+// Duerme hasta el instante en nanosegundos monotónicos
+static void dormirHasta(long long instante) {
+    struct timespec t;
+    t.tv_sec = instante / 1000000000LL;
+    t.tv_nsec = instante % 1000000000LL;
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, NULL) == EINTR) {
+    }
+}
+
+// Solicitante simulado del pid grabado; la primera vez se crea su pipe de respuesta. Se abre en
+// lectura/escritura para que el receptor siempre encuentre un lector. Devuelve NULL si no hay espacio
+static struct ClienteReplay *clienteDe(int pidGrabado) {
+    for (int k = 0; k < numClientes; k++) {
+        if (clientes[k].pidGrabado == pidGrabado) return &clientes[k];
+    }
+    if (numClientes == MAX_CLIENTES_REPLAY) return NULL;
+    struct ClienteReplay *c = &clientes[numClientes];
+    c->pidGrabado = pidGrabado;
+    c->id = ID_REPLAY(getpid(), numClientes);
+    snprintf(c->pipe, sizeof(c->pipe), "pipe_%d", c->id);
+    if (mkfifo(c->pipe, 0666) == -1 && errno != EEXIST) {
+        printf("Error al crear el pipe de respuesta %s\n", c->pipe);
+        return NULL;
+    }
+    c->fd = open(c->pipe, O_RDWR | O_NONBLOCK);
+    if (c->fd < 0) {
+        printf("Error al abrir el pipe de respuesta %s\n", c->pipe);
+        unlink(c->pipe);
+        return NULL;
+    }
+    pthread_mutex_lock(&mutexClientes);
+    numClientes++;
+    pthread_mutex_unlock(&mutexClientes);
+    return c;
+}
+
+// Copia la trama cambiando el pid del solicitante por id: es el tercer campo en un lote
+// "M,n,pid..." y el cuarto en "tipo,nombre,isbn,pid...". El campo s=cliente:sesion:secuencia se
+// quita: es de la ejecución grabada, y con él un segundo replay se contestaría entero desde la
+// ventana de duplicados del receptor en vez de aplicar las operaciones. Devuelve el largo de la copia
+static int cambiarPid(const char *trama, int largo, int id, char *salida, int tam) {
+    int campo = trama[0] == 'M' ? 2 : 3;
+    int k = 0;
+    for (int comas = 0; k < largo && comas < campo && trama[k] != '\n'; k++) {
+        if (trama[k] == ',') comas++;
+    }
+    //Si la trama no trae ese campo se manda igual
+    if (k >= largo || trama[k] == '\n' || (k > 0 && trama[k - 1] != ',')) {
+        memcpy(salida, trama, largo);
+        return largo;
+    }
+    int fin = k;
+    while (fin < largo && trama[fin] != ',' && trama[fin] != '\n') fin++;
+    int escrito = snprintf(salida, tam, "%.*s%d", k, trama, id);
+    //Los campos opcionales que siguen al pid se copian uno por uno, saltando el s=
+    while (fin < largo && trama[fin] == ',') {
+        int finCampo = fin + 1;
+        while (finCampo < largo && trama[finCampo] != ',' && trama[finCampo] != '\n') finCampo++;
+        if (finCampo - fin < 3 || strncmp(trama + fin + 1, "s=", 2) != 0) {
+            if (escrito + finCampo - fin >= tam) return -1;
+            memcpy(salida + escrito, trama + fin, finCampo - fin);
+            escrito += finCampo - fin;
+        }
+        fin = finCampo;
+    }
+    if (escrito + largo - fin >= tam) return -1;
+    memcpy(salida + escrito, trama + fin, largo - fin);
+    return escrito + largo - fin;
+}
+
+// Hilo que vacía los pipes de respuesta de los solicitantes simulados y cuenta las respuestas
+// (cada una termina en '\0')
+static void *lectorRespuestas(void *args) {
+    (void)args;
+    struct pollfd fds[MAX_CLIENTES_REPLAY];
+    char buffer[PIPE_BUF];
+    while (!terminar) {
+        pthread_mutex_lock(&mutexClientes);
+        int n = numClientes;
+        pthread_mutex_unlock(&mutexClientes);
+        for (int k = 0; k < n; k++) {
+            fds[k].fd = clientes[k].fd;
+            fds[k].events = POLLIN;
+        }
+        if (poll(fds, n, 50) <= 0) continue;
+        for (int k = 0; k < n; k++) {
+            if (!(fds[k].revents & POLLIN)) continue;
+            int bytes;
+            while ((bytes = read(fds[k].fd, buffer, sizeof(buffer))) > 0) {
+                long nuevas = 0;
+                for (int b = 0; b < bytes; b++) {
+                    if (buffer[b] == '\0') nuevas++;
+                }
+                pthread_mutex_lock(&mutexClientes);
+                respuestas += nuevas;
+                ultimaRespuesta = ahoraNs();
+                pthread_mutex_unlock(&mutexClientes);
+            }
+        }
+    }
+    return NULL;
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 5 || argc > 7) {
+        printf("\n \t\tUse: $./replay –p pipeReceptor –g filegrabacion [-x factor]\n");
+        exit(1);
+    }
+    char *pipeRec = NULL;
+    char *fileGrabacion = NULL;
+    double factor = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            pipeRec = argv[++i];
+        } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            fileGrabacion = argv[++i];
+        } else if (strcmp(argv[i], "-x") == 0 && i + 1 < argc) {
+            //1 es el ritmo grabado, 10 diez veces más rápido y 0 sin pausas
+            factor = atof(argv[++i]);
+        }
+    }
+    if (!pipeRec || !fileGrabacion) {
+        printf("\n \t\tUse: $./replay –p pipeReceptor –g filegrabacion [-x factor]\n");
+        exit(1);
+    }
+    if (factor < 0) {
+        printf("Error: -x debe ser 0 (sin pausas) o mayor\n");
+        exit(1);
+    }
+    FILE *grabacion = fopen(fileGrabacion, "rb");
+    char magia[LARGO_MAGIA];
+    if (!grabacion || fread(magia, 1, LARGO_MAGIA, grabacion) != LARGO_MAGIA || memcmp(magia, MAGIA_GRABACION, LARGO_MAGIA) != 0) {
+        printf("Error: %s no es una grabación del receptor\n", fileGrabacion);
+        exit(1);
+    }
+    int fd = open(pipeRec, O_WRONLY);
+    if (fd < 0) {
+        printf("Error al abrir el pipe %s, verifique que el receptor esté corriendo\n", pipeRec);
+        exit(1);
+    }
+    //Si el receptor se cae, write devuelve error en vez de matar al replay
+    signal(SIGPIPE, SIG_IGN);
+    pthread_t hiloLector;
+    pthread_create(&hiloLector, NULL, lectorRespuestas, NULL);
+
+    struct RegistroGrabacion registro;
+    char trama[MAX_TRAMA_GRABADA];
+    char mensaje[MAX_TRAMA_GRABADA + 32];
+    long enviadas = 0, operaciones = 0, omitidas = 0;
+    long long grabadoUs = 0, atrasoMax = 0;
+    long long inicio = ahoraNs();
+    while (fread(&registro, sizeof(registro), 1, grabacion) == 1) {
+        if (registro.largo <= 0 || registro.largo > MAX_TRAMA_GRABADA || fread(trama, 1, registro.largo, grabacion) != (size_t)registro.largo) {
+            printf("Grabación cortada o inválida después de %ld tramas\n", enviadas + omitidas);
+            break;
+        }
+        grabadoUs = registro.tUs;
+        //La Q terminaría el receptor, así que no se repite
+        if (trama[0] == 'Q') {
+            omitidas++;
+            continue;
+        }
+        struct ClienteReplay *c = clienteDe(registro.pid);
+        if (!c) {
+            omitidas++;
+            continue;
+        }
+        int largo = cambiarPid(trama, registro.largo, c->id, mensaje, sizeof(mensaje) - 1);
+        if (largo < 0) {
+            omitidas++;
+            continue;
+        }
+        mensaje[largo] = '\0';
+        if (factor > 0) {
+            long long objetivo = inicio + (long long)(registro.tUs * 1000 / factor);
+            long long ahora = ahoraNs();
+            if (ahora < objetivo) {
+                dormirHasta(objetivo);
+            } else if (ahora - objetivo > atrasoMax) {
+                atrasoMax = ahora - objetivo;
+            }
+        }
+        if (write(fd, mensaje, largo + 1) == -1) {
+            printf("Error al escribir en el pipe %s, el receptor ya no está leyendo\n", pipeRec);
+            break;
+        }
+        enviadas++;
+        int num;
+        operaciones += trama[0] == 'M' && sscanf(mensaje, "M,%d", &num) == 1 ? num : 1;
+    }
+    long long finEnvio = ahoraNs();
+    fclose(grabacion);
+    close(fd);
+
+    //Se esperan las respuestas hasta que haya una por trama o pase ESPERA_FINAL_MS sin ninguna nueva
+    while (1) {
+        pthread_mutex_lock(&mutexClientes);
+        long recibidas = respuestas;
+        long long ultima = ultimaRespuesta > finEnvio ? ultimaRespuesta : finEnvio;
+        pthread_mutex_unlock(&mutexClientes);
+        if (recibidas >= enviadas || ahoraNs() - ultima > ESPERA_FINAL_MS * 1000000LL) break;
+        usleep(10000);
+    }
+    terminar = 1;
+    pthread_join(hiloLector, NULL);
+    for (int k = 0; k < numClientes; k++) {
+        close(clientes[k].fd);
+        unlink(clientes[k].pipe);
+    }
+
+    double segundos = (finEnvio - inicio) / 1e9;
+    printf("Grabación %s: %ld tramas (%ld operaciones) de %d solicitantes, %.3f s grabados, %ld omitidas (Q o inválidas)\n",
+           fileGrabacion, enviadas, operaciones, numClientes, grabadoUs / 1e6, omitidas);
+    if (factor > 0) {
+        printf("Reenviadas a x%g en %.3f s (%.0f ops/s), atraso máximo respecto a la grabación %.3f ms\n",
+               factor, segundos, segundos > 0 ? operaciones / segundos : 0, atrasoMax / 1e6);
+    } else {
+        printf("Reenviadas sin pausas en %.3f s (%.0f ops/s)\n", segundos, segundos > 0 ? operaciones / segundos : 0);
+    }
+    printf("Respuestas recibidas: %ld para %ld tramas\n", respuestas, enviadas);
+    return 0;
+}
@@ -0,0 +1,33 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: replay.h
+#	Descripcion: Archivo de encabezado para replay.c.
+#                Define los solicitantes simulados con los que se repite una grabación
+#****************************************************************/
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "grabacion.h"
+
+#define MAX_CLIENTES_REPLAY 256
+// Tiempo sin respuestas nuevas después de la última trama para dar por terminada la repetición
+#define ESPERA_FINAL_MS 2000
+// Cada solicitante grabado se repite con un identificador propio: mayor que los pids de Linux y que
+// los del router, y distinto para cada replay que corra a la vez
+#define ID_BASE_REPLAY (1 << 30)
+#define ID_REPLAY(pidReplay, k) (ID_BASE_REPLAY + ((pidReplay) % 4096) * MAX_CLIENTES_REPLAY + (k))
+
+// Un solicitante de la grabación y el pipe donde recibe sus respuestas durante la repetición
+struct ClienteReplay {
+    int pidGrabado;
+    int id;
+    int fd;
+    char pipe[64];
+};
+
+#endif
@@ -0,0 +1,403 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: respuestas.c
+#	Descripcion: Escritura de las respuestas a los solicitantes. enviarRespuesta solo deja la
+#                respuesta en la cola de salida del solicitante; un grupo de hilos escritores abre
+#                los pipes sin bloquear y escribe, y si el pipe no está abierto o está lleno vuelve a
+#                intentar más tarde con un temporizador. Así un solicitante lento nunca detiene a los
+#                hilos que procesan operaciones. Las respuestas pendientes de un mismo solicitante se
+#                escriben juntas con un solo writev de hasta PIPE_BUF bytes.
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include "respuestas.h"
+#include "afinidad.h"
+#include "receptor.h"
+#include "metricas.h"
+#include "bitacora.h"
+
+// Resultado de un intento de escritura
+enum ResultadoEnvio {
+    ENVIO_COMPLETO,   // la primera respuesta quedó escrita completa
+    ENVIO_SIN_PIPE,   // el pipe no existe o el solicitante todavía no lo abrió
+    ENVIO_LLENO,      // el pipe está lleno; puede haberse escrito una parte
+    ENVIO_FALLIDO     // error de escritura (por ejemplo, el solicitante ya cerró)
+};
+
+static struct Escritor *escritores = NULL;
+static int numEscritores = 0;
+// Cuánto puede esperar la primera respuesta de una cola para juntarse con otras (ns) y cuántos
+// bytes se juntan como máximo; al llegar a esos bytes se escribe sin esperar
+static long long esperaAgrupar = 0;
+static int bytesAgrupar = PIPE_BUF;
+
+static void *escritor(void *args);
+
+// Crea los hilos escritores. Cada solicitante queda siempre con el mismo escritor, así sus
+// respuestas llegan en el orden en que se encolaron. Las respuestas de un solicitante se juntan hasta
+// bytes (como máximo PIPE_BUF, para que cada escritura sea atómica) o hasta que la primera lleve
+// esperaUs esperando. Devuelve 0 si no se pudieron crear
+int iniciarEscritores(int cantidad, int esperaUs, int bytes) {
+    escritores = calloc(cantidad, sizeof(struct Escritor));
+    if (!escritores) {
+        return 0;
+    }
+    numEscritores = cantidad;
+    esperaAgrupar = esperaUs * 1000LL;
+    bytesAgrupar = bytes;
+    // Los reintentos se programan con el reloj monotónico, igual que tiempoNs
+    pthread_condattr_t atributos;
+    pthread_condattr_init(&atributos);
+    pthread_condattr_setclock(&atributos, CLOCK_MONOTONIC);
+    for (int k = 0; k < cantidad; k++) {
+        pthread_mutex_init(&escritores[k].mutex, NULL);
+        pthread_cond_init(&escritores[k].hayRespuestas, &atributos);
+        pthread_create(&escritores[k].hilo, NULL, escritor, &escritores[k]);
+        char nombre[32];
+        snprintf(nombre, sizeof(nombre), "escritor %d", k);
+        fijarHilo(ROL_ESCRITURA, escritores[k].hilo, nombre);
+    }
+    pthread_condattr_destroy(&atributos);
+    return 1;
+}
+
+// Cola de salida del pid o una libre para él. Devuelve NULL si no hay casillas libres
+static struct Salida *buscarSalida(struct Escritor *e, int pid) {
+    struct Salida *libre = NULL;
+    for (int k = 0; k < MAX_CLIENTES_ESCRITOR; k++) {
+        struct Salida *s = &e->salidas[k];
+        if (s->ocupada && s->pid == pid) return s;
+        if (!s->ocupada && !libre) libre = s;
+    }
+    if (libre) {
+        memset(libre, 0, sizeof(*libre));
+        libre->pid = pid;
+        libre->ocupada = 1;
+        libre->fd = -1;
+    }
+    return libre;
+}
+
+// Arma una respuesta compacta (codigos.h) sin llamadas de formato: la marca, el código y los cuatro
+// campos de 7 bits por byte. respuesta debe tener LARGO_COMPACTA + 1 bytes. Devuelve su largo sin '\0'
+int armarRespuesta(char *respuesta, int codigo, int isbn, int a, int b, int c) {
+    int campos[CAMPOS_COMPACTA] = {isbn, a, b, c};
+    char *p = respuesta;
+    *p++ = MARCA_COMPACTA;
+    *p++ = (char)codigo;
+    for (int k = 0; k < CAMPOS_COMPACTA; k++) {
+        unsigned int valor = campos[k] < 0 ? 0 : campos[k] > MAX_CAMPO_COMPACTA ? MAX_CAMPO_COMPACTA : campos[k];
+        for (int byte = BYTES_CAMPO - 1; byte >= 0; byte--) {
+            *p++ = (char)(0x80 | ((valor >> (7 * byte)) & 0x7F));
+        }
+    }
+    *p = '\0';
+    return LARGO_COMPACTA;
+}
+
+// Deja una respuesta en la cola de salida del solicitante y despierta a su escritor. Nunca espera
+// por el pipe: si la cola del solicitante está llena la respuesta se descarta y se cuenta
+void enviarRespuesta(int pid, const char *mensaje) {
+    enviarRespuestaTraza(pid, mensaje, NULL, 0, 0);
+}
+
+// Como enviarRespuesta, pero con -T la respuesta lleva una copia de las marcas de la operación y el
+// escritor registra la traza cuando la termina de escribir (o la descarta). Si la respuesta no
+// alcanza a encolarse la traza se registra aquí mismo
+void enviarRespuestaTraza(int pid, const char *mensaje, const struct Traza *traza, char tipo, int isbn) {
+    struct TrazaSalida *copiaTraza = NULL;
+    if (traza && trazaActiva) {
+        copiaTraza = malloc(sizeof(*copiaTraza));
+        if (copiaTraza) {
+            copiaTraza->traza = *traza;
+            copiaTraza->tipo = tipo;
+            copiaTraza->isbn = isbn;
+        } else {
+            registrarTraza(traza, tipo, isbn, pid);
+        }
+    }
+    int largo = strlen(mensaje) + 1;
+    char *copia = malloc(largo);
+    if (!copia) {
+        atomic_fetch_add(&respuestasDescartadas, 1);
+        registrar(LOG_ERROR, "No se pudo reservar memoria para la respuesta a %d", pid);
+        if (copiaTraza) {
+            registrarTraza(&copiaTraza->traza, tipo, isbn, pid);
+            free(copiaTraza);
+        }
+        return;
+    }
+    memcpy(copia, mensaje, largo);
+
+    struct Escritor *e = &escritores[(unsigned)pid % numEscritores];
+    pthread_mutex_lock(&e->mutex);
+    struct Salida *s = buscarSalida(e, pid);
+    if (!s || s->cont == MAX_PENDIENTES_CLIENTE) {
+        pthread_mutex_unlock(&e->mutex);
+        free(copia);
+        atomic_fetch_add(&respuestasDescartadas, 1);
+        registrar(LOG_AVISO, "Cola de salida de %d llena, se descarta la respuesta", pid);
+        if (copiaTraza) {
+            registrarTraza(&copiaTraza->traza, tipo, isbn, pid);
+            free(copiaTraza);
+        }
+        return;
+    }
+    int pos = (s->inicio + s->cont) % MAX_PENDIENTES_CLIENTE;
+    s->mensajes[pos] = copia;
+    s->largos[pos] = largo;
+    s->tiempos[pos] = tiempoNs();
+    s->trazas[pos] = copiaTraza;
+    s->cont++;
+    s->bytes += largo;
+    e->pendientes++;
+    atomic_fetch_add(&respuestasPendientes, 1);
+    //El escritor se despierta con la primera respuesta de la cola o cuando ya se juntaron los bytes;
+    //en los demás casos ya tiene programado cuándo escribir
+    if (s->cont == 1 || (s->bytes >= bytesAgrupar && s->bytes - largo < bytesAgrupar)) {
+        pthread_cond_signal(&e->hayRespuestas);
+    }
+    pthread_mutex_unlock(&e->mutex);
+}
+
+// Saca la primera respuesta de la cola (escrita o descartada) y registra su traza si la lleva.
+// Cuando la cola queda vacía se cierra el pipe y se libera la casilla. Debe llamarse con el mutex
+// del escritor tomado
+static void quitarPrimera(struct Escritor *e, struct Salida *s) {
+    s->bytes -= s->largos[s->inicio];
+    free(s->mensajes[s->inicio]);
+    struct TrazaSalida *t = s->trazas[s->inicio];
+    if (t) {
+        registrarTraza(&t->traza, t->tipo, t->isbn, s->pid);
+        free(t);
+        s->trazas[s->inicio] = NULL;
+    }
+    s->inicio = (s->inicio + 1) % MAX_PENDIENTES_CLIENTE;
+    s->cont--;
+    s->enviado = 0;
+    s->intentos = 0;
+    s->proximoIntento = 0;
+    e->pendientes--;
+    atomic_fetch_sub(&respuestasPendientes, 1);
+    if (s->cont == 0) {
+        if (s->fd >= 0) close(s->fd);
+        s->ocupada = 0;
+    }
+}
+
+// Instante desde el que se puede escribir la cola: el del reintento programado o, si no se han
+// juntado los bytes, el de la primera respuesta más la espera para agrupar. Al cerrar no se espera
+static long long listaDesde(struct Escritor *e, struct Salida *s) {
+    long long desde = s->proximoIntento;
+    if (s->enviado == 0 && s->bytes < bytesAgrupar && !e->cerrado) {
+        long long plazo = s->tiempos[s->inicio] + esperaAgrupar;
+        if (plazo > desde) desde = plazo;
+    }
+    return desde;
+}
+
+// Arma en iov lo que se escribe en el siguiente intento: lo que falta de la primera respuesta si
+// quedó a medias o no cabe en PIPE_BUF, o si no las respuestas completas que quepan en bytesAgrupar
+// (al menos una). Debe llamarse con el mutex del escritor tomado. Devuelve cuántas partes armó
+static int armarEnvio(struct Salida *s, struct iovec *iov) {
+    int largo = s->largos[s->inicio];
+    iov[0].iov_base = s->mensajes[s->inicio] + s->enviado;
+    iov[0].iov_len = largo - s->enviado;
+    if (s->enviado > 0 || largo > PIPE_BUF) {
+        return 1;
+    }
+    int num = 1, total = largo;
+    while (num < s->cont) {
+        int pos = (s->inicio + num) % MAX_PENDIENTES_CLIENTE;
+        if (total + s->largos[pos] > bytesAgrupar) break;
+        iov[num].iov_base = s->mensajes[pos];
+        iov[num].iov_len = s->largos[pos];
+        total += s->largos[pos];
+        num++;
+    }
+    return num;
+}
+
+// Marca el primer intento de escritura de las num respuestas armadas que se trazan. Los intentos
+// siguientes (reaperturas y reintentos con el pipe lleno) quedan dentro de la misma escritura
+static void marcarEscritura(struct Salida *s, int num) {
+    long long ahora = tiempoNs();
+    for (int k = 0; k < num; k++) {
+        struct TrazaSalida *t = s->trazas[(s->inicio + k) % MAX_PENDIENTES_CLIENTE];
+        if (t && t->traza.marcas[TRAZA_ESCRIBIENDO] == 0) {
+            t->traza.marcas[TRAZA_ESCRIBIENDO] = ahora;
+        }
+    }
+}
+
+// Intenta escribir las partes armadas, abriendo el pipe si hace falta. No bloquea: el pipe se abre y
+// se escribe con O_NONBLOCK. Hasta PIPE_BUF bytes la escritura es atómica (todo o nada); una
+// respuesta más grande puede quedar escrita en parte. Solo la llama el escritor dueño de la cola
+static enum ResultadoEnvio intentarEnvio(struct Salida *s, struct iovec *iov, int num, ssize_t *escritos) {
+    *escritos = 0;
+    if (s->fd < 0) {
+        char nombre[20];
+        snprintf(nombre, sizeof(nombre), "pipe_%d", s->pid);
+        //Sin lector abierto open falla con ENXIO en lugar de esperar
+        s->fd = open(nombre, O_WRONLY | O_NONBLOCK);
+        if (s->fd < 0) {
+            return ENVIO_SIN_PIPE;
+        }
+        atomic_fetch_add(&respuestaAperturas, 1);
+    }
+    size_t total = 0;
+    for (int k = 0; k < num; k++) {
+        total += iov[k].iov_len;
+    }
+    ssize_t bytes = writev(s->fd, iov, num);
+    atomic_fetch_add(&respuestaEscrituras, 1);
+    if (bytes > 0) {
+        *escritos = bytes;
+        return (size_t)bytes == total ? ENVIO_COMPLETO : ENVIO_LLENO;
+    }
+    if (bytes < 0 && (errno == EAGAIN || errno == EINTR)) {
+        return ENVIO_LLENO;
+    }
+    return ENVIO_FALLIDO;
+}
+
+// Saca de la cola las respuestas que quedaron escritas por completo y anota lo que se escribió de
+// la siguiente. Debe llamarse con el mutex del escritor tomado
+static void consumir(struct Escritor *e, struct Salida *s, ssize_t escritos) {
+    while (escritos > 0 && s->ocupada) {
+        int resto = s->largos[s->inicio] - s->enviado;
+        if (escritos < resto) {
+            s->enviado += escritos;
+            return;
+        }
+        escritos -= resto;
+        atomic_fetch_add(&respuestasEscritas, 1);
+        if (s->trazas[s->inicio]) {
+            MARCAR_TRAZA(&s->trazas[s->inicio]->traza, TRAZA_ESCRITO);
+        }
+        quitarPrimera(e, s);
+    }
+}
+
+// Aplica el resultado de un intento a la cola: programa el siguiente intento o descarta lo que ya no
+// se puede entregar. Debe llamarse con el mutex del escritor tomado, después de consumir lo escrito
+static void aplicarResultado(struct Escritor *e, struct Salida *s, enum ResultadoEnvio resultado, int avanzo) {
+    long long ahora = tiempoNs();
+    if (resultado == ENVIO_COMPLETO || !s->ocupada) {
+        return;
+    } else if (resultado == ENVIO_SIN_PIPE) {
+        //Si el solicitante no abre su pipe en INTENTOS_APERTURA intentos se descarta toda su cola
+        if (++s->intentos < INTENTOS_APERTURA) {
+            atomic_fetch_add(&respuestaReintentos, 1);
+            s->proximoIntento = ahora + ESPERA_APERTURA_MS * 1000000LL;
+            return;
+        }
+        registrar(LOG_ERROR, "No se pudo abrir el pipe pipe_%d, se descartan %d respuestas", s->pid, s->cont);
+        while (s->ocupada) {
+            atomic_fetch_add(&respuestaFallosApertura, 1);
+            quitarPrimera(e, s);
+        }
+    } else if (resultado == ENVIO_LLENO) {
+        //Mientras el solicitante vaya leyendo no se cuentan intentos; la espera crece hasta el máximo
+        s->intentos = avanzo ? 0 : s->intentos + 1;
+        if (s->intentos < INTENTOS_ESCRITURA) {
+            long long espera = s->intentos < 7 ? 1LL << s->intentos : MAX_ESPERA_ESCRITURA_MS;
+            if (espera > MAX_ESPERA_ESCRITURA_MS) espera = MAX_ESPERA_ESCRITURA_MS;
+            s->proximoIntento = ahora + espera * 1000000LL;
+            return;
+        }
+        atomic_fetch_add(&respuestaFallosEscritura, 1);
+        registrar(LOG_ERROR, "El pipe pipe_%d siguió lleno, se descarta una respuesta", s->pid);
+        quitarPrimera(e, s);
+    } else {
+        atomic_fetch_add(&respuestaFallosEscritura, 1);
+        registrar(LOG_ERROR, "Error al escribir en el pipe pipe_%d", s->pid);
+        //El pipe se vuelve a abrir para la siguiente respuesta
+        if (s->fd >= 0) {
+            close(s->fd);
+            s->fd = -1;
+        }
+        quitarPrimera(e, s);
+    }
+}
+
+// Hilo escritor. Busca una cola que ya se pueda escribir y la vacía mientras el pipe acepte; la
+// escritura se hace sin el mutex, así encolar nunca espera a un pipe. Si no hay nada listo duerme
+// hasta el reintento o el plazo de agrupación más próximo, o hasta que llegue una respuesta. Al
+// cerrarse termina cuando ya entregó (o descartó) todo lo pendiente
+static void *escritor(void *args) {
+    struct Escritor *e = (struct Escritor *)args;
+    struct iovec iov[MAX_PENDIENTES_CLIENTE];
+    pthread_mutex_lock(&e->mutex);
+    while (1) {
+        long long ahora = tiempoNs();
+        long long proximo = LLONG_MAX;
+        struct Salida *s = NULL;
+        for (int k = 0; k < MAX_CLIENTES_ESCRITOR; k++) {
+            struct Salida *candidata = &e->salidas[(e->siguiente + k) % MAX_CLIENTES_ESCRITOR];
+            if (!candidata->ocupada || candidata->cont == 0) continue;
+            long long desde = listaDesde(e, candidata);
+            if (desde <= ahora) {
+                s = candidata;
+                e->siguiente = (candidata - e->salidas + 1) % MAX_CLIENTES_ESCRITOR;
+                break;
+            }
+            if (desde < proximo) proximo = desde;
+        }
+
+        if (s) {
+            //Se escriben las respuestas del solicitante hasta vaciar su cola o tener que esperar
+            while (s->ocupada && listaDesde(e, s) <= ahora) {
+                int num = armarEnvio(s, iov);
+                if (trazaActiva) marcarEscritura(s, num);
+                ssize_t escritos;
+                pthread_mutex_unlock(&e->mutex);
+                enum ResultadoEnvio resultado = intentarEnvio(s, iov, num, &escritos);
+                pthread_mutex_lock(&e->mutex);
+                consumir(e, s, escritos);
+                aplicarResultado(e, s, resultado, escritos > 0);
+            }
+            continue;
+        }
+        if (e->cerrado && e->pendientes == 0) break;
+        if (proximo == LLONG_MAX) {
+            pthread_cond_wait(&e->hayRespuestas, &e->mutex);
+        } else {
+            struct timespec limite = {proximo / 1000000000LL, proximo % 1000000000LL};
+            pthread_cond_timedwait(&e->hayRespuestas, &e->mutex, &limite);
+        }
+    }
+    pthread_mutex_unlock(&e->mutex);
+    return NULL;
+}
+
+// Espera a que los escritores entreguen lo pendiente y los libera. Se llama cuando ya ningún hilo
+// va a responder
+void detenerEscritores(void) {
+    for (int k = 0; k < numEscritores; k++) {
+        pthread_mutex_lock(&escritores[k].mutex);
+        escritores[k].cerrado = 1;
+        pthread_cond_signal(&escritores[k].hayRespuestas);
+        pthread_mutex_unlock(&escritores[k].mutex);
+    }
+    for (int k = 0; k < numEscritores; k++) {
+        pthread_join(escritores[k].hilo, NULL);
+        pthread_mutex_destroy(&escritores[k].mutex);
+        pthread_cond_destroy(&escritores[k].hayRespuestas);
+    }
+    free(escritores);
+    escritores = NULL;
+    numEscritores = 0;
+}
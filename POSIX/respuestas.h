@@ -0,0 +1,80 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: respuestas.h
+#	Descripcion: Archivo de encabezado para respuestas.c.
+#                Define las colas de salida por solicitante y los hilos escritores que las vacían
+#                en los pipes de respuesta sin bloquear a los hilos que procesan operaciones
+#****************************************************************/
+
+#ifndef RESPUESTAS_H
+#define RESPUESTAS_H
+
+#include <pthread.h>
+#include "traza.h"
+
+// Hilos escritores por defecto (-R) y máximo
+#define ESCRITORES_DEFECTO 2
+#define MAX_ESCRITORES 8
+// Solicitantes con respuestas pendientes por escritor y respuestas pendientes por solicitante
+#define MAX_CLIENTES_ESCRITOR 256
+#define MAX_PENDIENTES_CLIENTE 64
+// Reintentos para abrir el pipe de un solicitante que todavía no lo abrió, cada ESPERA_APERTURA_MS
+#define INTENTOS_APERTURA 5
+#define ESPERA_APERTURA_MS 100
+// Con el pipe lleno se reintenta a 1, 2, 4... ms, hasta MAX_ESPERA_ESCRITURA_MS entre intentos y
+// INTENTOS_ESCRITURA intentos antes de descartar la respuesta
+#define MAX_ESPERA_ESCRITURA_MS 100
+#define INTENTOS_ESCRITURA 60
+// Por defecto (-j) las respuestas pendientes de un solicitante se escriben apenas el escritor las ve,
+// juntas en un writev de hasta PIPE_BUF bytes
+#define ESPERA_AGRUPAR_DEFECTO_US 0
+#define MAX_ESPERA_AGRUPAR_US 100000
+
+// Marcas de la operación que viajan con su respuesta (solo con -T) hasta que el escritor la entrega
+struct TrazaSalida {
+    struct Traza traza;
+    char tipo;
+    int isbn;
+};
+
+// Respuestas de un solicitante que esperan ser escritas, en orden. Solo el escritor dueño de la
+// cola escribe en el pipe y saca respuestas; los demás hilos solo agregan al final
+struct Salida {
+    int pid;
+    int ocupada; // 0 si la casilla está libre
+    char *mensajes[MAX_PENDIENTES_CLIENTE];
+    int largos[MAX_PENDIENTES_CLIENTE]; // Bytes de cada respuesta con su '\0'
+    long long tiempos[MAX_PENDIENTES_CLIENTE]; // Instante en que se encoló cada respuesta
+    struct TrazaSalida *trazas[MAX_PENDIENTES_CLIENTE]; // NULL si la respuesta no se traza
+    int bytes; // Bytes pendientes en la cola
+    int inicio;
+    int cont;
+    int enviado; // Bytes ya escritos de la primera respuesta
+    int fd; // Pipe abierto mientras haya respuestas, -1 si no
+    int intentos;
+    long long proximoIntento; // Instante (ns monotónicos) del siguiente intento, 0 para ya
+};
+
+// Un hilo escritor con los solicitantes que le tocan (pid % número de escritores)
+struct Escritor {
+    pthread_t hilo;
+    pthread_mutex_t mutex;
+    pthread_cond_t hayRespuestas;
+    struct Salida salidas[MAX_CLIENTES_ESCRITOR];
+    int siguiente; // Casilla por la que empieza la próxima revisión, para no favorecer a las primeras
+    int pendientes; // Respuestas en todas sus colas
+    int cerrado;
+};
+
+// Funciones de los escritores de respuestas
+int iniciarEscritores(int cantidad, int esperaUs, int bytes);
+int armarRespuesta(char *respuesta, int codigo, int isbn, int a, int b, int c);
+void enviarRespuesta(int pid, const char *mensaje);
+void enviarRespuestaTraza(int pid, const char *mensaje, const struct Traza *traza, char tipo, int isbn);
+void detenerEscritores(void);
+
+#endif
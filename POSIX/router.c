@@ -0,0 +1,818 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: router.c
+#	Descripcion: Router que recibe las tramas de los solicitantes en el pipe de siempre y reparte
+#                cada operación entre varios receptores según el ISBN, con rangos o por hash leídos
+#                de un archivo de rutas. Las respuestas vuelven por pipes del router, que las entrega
+#                al solicitante; B y L se mandan a todos los receptores y los lotes se parten por
+#                receptor, y en esos casos las respuestas se combinan en una sola.
+#                Lleva estadísticas por receptor (tramas, operaciones, respuestas, fallos, latencia).
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "router.h"
+
+// Receptores y reglas de reparto leídas del archivo de rutas
+struct Backend backends[MAX_BACKENDS];
+int numBackends = 0;
+struct Rango rangos[MAX_RANGOS];
+int numRangos = 0;
+int terminar = 0;
+int verbose = 0;
+
+// Canales de respuesta y operaciones pendientes, protegidos por mutexRouter
+static struct Canal canales[MAX_CANALES];
+static struct Pendiente pendientes[MAX_PENDIENTES];
+static pthread_mutex_t mutexRouter = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t condCanal = PTHREAD_COND_INITIALIZER;
+// Pipe interno para despertar al hilo de relevo cuando cambian los canales
+static int despertar[2];
+
+// Instante actual en nanosegundos monotónicos
+static long long ahoraNs(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (long long)t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+// Lee el archivo de rutas. Cada línea es "pipe desde hasta" (rango de ISBN) o "pipe *" (entra al
+// reparto por hash de los ISBN que no caen en ningún rango); '#' empieza un comentario.
+// Devuelve 0 si el archivo no existe o tiene una línea inválida
+int leerRutas(const char *archivo) {
+    FILE *f = fopen(archivo, "r");
+    if (!f) {
+        printf("Error al abrir el archivo de rutas %s\n", archivo);
+        return 0;
+    }
+    char linea[512];
+    int numLinea = 0;
+    while (fgets(linea, sizeof(linea), f)) {
+        numLinea++;
+        char *comentario = strchr(linea, '#');
+        if (comentario) *comentario = '\0';
+        char pipe[256], desde[32], hasta[32];
+        int campos = sscanf(linea, "%255s %31s %31s", pipe, desde, hasta);
+        if (campos <= 0) continue;
+        if (campos == 1 || (strcmp(desde, "*") != 0 && campos != 3)) {
+            printf("Error en la línea %d de %s: se esperaba \"pipe desde hasta\" o \"pipe *\"\n", numLinea, archivo);
+            fclose(f);
+            return 0;
+        }
+        //Se busca el receptor o se agrega si es la primera vez que aparece
+        int b = 0;
+        while (b < numBackends && strcmp(backends[b].pipe, pipe) != 0) b++;
+        if (b == numBackends) {
+            if (numBackends == MAX_BACKENDS) {
+                printf("Error: Máximo %d receptores en %s\n", MAX_BACKENDS, archivo);
+                fclose(f);
+                return 0;
+            }
+            snprintf(backends[b].pipe, sizeof(backends[b].pipe), "%s", pipe);
+            backends[b].fd = -1;
+            numBackends++;
+        }
+        if (strcmp(desde, "*") == 0) {
+            backends[b].porHash = 1;
+            continue;
+        }
+        if (numRangos == MAX_RANGOS || atoi(desde) > atoi(hasta)) {
+            printf("Error en la línea %d de %s: rango inválido o demasiados rangos\n", numLinea, archivo);
+            fclose(f);
+            return 0;
+        }
+        rangos[numRangos].desde = atoi(desde);
+        rangos[numRangos].hasta = atoi(hasta);
+        rangos[numRangos].backend = b;
+        numRangos++;
+    }
+    fclose(f);
+    return numBackends > 0;
+}
+
+// Receptor que atiende un ISBN: el del primer rango que lo contiene o, si ninguno, uno de los
+// receptores por hash. Devuelve -1 si ningún receptor lo atiende
+int backendDeIsbn(int isbn) {
+    for (int r = 0; r < numRangos; r++) {
+        if (isbn >= rangos[r].desde && isbn <= rangos[r].hasta) {
+            return rangos[r].backend;
+        }
+    }
+    int porHash = 0;
+    for (int b = 0; b < numBackends; b++) {
+        porHash += backends[b].porHash;
+    }
+    if (porHash == 0) return -1;
+    int elegido = (int)((unsigned)isbn % (unsigned)porHash);
+    for (int b = 0; b < numBackends; b++) {
+        if (backends[b].porHash && elegido-- == 0) return b;
+    }
+    return -1;
+}
+
+// Abre el pipe de cada receptor. Se abre sin bloqueo para fallar de una vez si el receptor no
+// está corriendo y después se deja bloqueante como los solicitantes. Devuelve 0 si alguno falla
+int abrirBackends(void) {
+    for (int b = 0; b < numBackends; b++) {
+        backends[b].fd = open(backends[b].pipe, O_WRONLY | O_NONBLOCK);
+        if (backends[b].fd < 0) {
+            printf("Error al abrir el pipe del receptor %s, verifique que esté corriendo\n", backends[b].pipe);
+            return 0;
+        }
+        fcntl(backends[b].fd, F_SETFL, fcntl(backends[b].fd, F_GETFL) & ~O_NONBLOCK);
+    }
+    return 1;
+}
+
+// Busca la operación pendiente de un solicitante. Debe llamarse con mutexRouter tomado
+static struct Pendiente *buscarPendiente(int pid) {
+    for (int k = 0; k < MAX_PENDIENTES; k++) {
+        if (pendientes[k].pid == pid) return &pendientes[k];
+    }
+    return NULL;
+}
+
+// Libera una operación pendiente y las partes que haya guardado. Debe llamarse con mutexRouter tomado
+static void liberarPendiente(struct Pendiente *p) {
+    for (int b = 0; b < MAX_BACKENDS; b++) {
+        free(p->partes[b]);
+        p->partes[b] = NULL;
+    }
+    p->pid = 0;
+}
+
+// Registra la operación que un solicitante acaba de mandar. Si tenía una anterior sin terminar
+// (el solicitante dejó de esperarla) se descarta. Devuelve NULL si no hay casillas libres
+static struct Pendiente *registrarPendiente(int pid, char tipo, const char *nombre, int pagina, int esperadas, int combinar) {
+    pthread_mutex_lock(&mutexRouter);
+    struct Pendiente *p = buscarPendiente(pid);
+    if (p) {
+        liberarPendiente(p);
+    } else {
+        p = buscarPendiente(0);
+    }
+    if (p) {
+        p->pid = pid;
+        p->tipo = tipo;
+        snprintf(p->nombre, sizeof(p->nombre), "%s", nombre);
+        p->pagina = pagina;
+        p->esperadas = esperadas;
+        p->recibidas = 0;
+        p->combinar = combinar;
+        p->num = 1;
+        p->tEnvio = ahoraNs();
+    }
+    pthread_mutex_unlock(&mutexRouter);
+    return p;
+}
+
+// Deja abierto el pipe por el que el receptor b responde al solicitante pid. El pipe tiene que
+// estar abierto antes de reenviar, porque el receptor lo abre para escribir y se bloquearía sin
+// lector. Si no hay casillas libres se cierra el canal menos usado de un solicitante sin
+// operaciones pendientes. Devuelve 0 si no se pudo abrir
+int abrirCanal(int pid, int b) {
+    int id = ID_ROUTER(pid, b);
+    pthread_mutex_lock(&mutexRouter);
+    while (1) {
+        int libre = -1, victima = -1;
+        for (int k = 0; k < MAX_CANALES; k++) {
+            if (canales[k].id == id && !canales[k].cerrar) {
+                canales[k].usado = ahoraNs();
+                pthread_mutex_unlock(&mutexRouter);
+                return 1;
+            }
+            if (canales[k].id == 0) {
+                if (libre < 0) libre = k;
+            } else if (!canales[k].cerrar && !buscarPendiente(PID_DE_ID(canales[k].id)) &&
+                       (victima < 0 || canales[k].usado < canales[victima].usado)) {
+                victima = k;
+            }
+        }
+        if (libre >= 0) {
+            char nombre[32];
+            snprintf(nombre, sizeof(nombre), "pipe_%d", id);
+            if (mkfifo(nombre, 0666) == -1 && errno != EEXIST) {
+                pthread_mutex_unlock(&mutexRouter);
+                return 0;
+            }
+            int fd = open(nombre, O_RDWR);
+            if (fd < 0) {
+                unlink(nombre);
+                pthread_mutex_unlock(&mutexRouter);
+                return 0;
+            }
+            canales[libre].id = id;
+            canales[libre].fd = fd;
+            canales[libre].len = 0;
+            canales[libre].usado = ahoraNs();
+            pthread_mutex_unlock(&mutexRouter);
+            //El hilo de relevo vuelve a armar su lista de pipes
+            if (write(despertar[1], "c", 1) < 0) {
+                perror("write");
+            }
+            return 1;
+        }
+        if (victima < 0) {
+            pthread_mutex_unlock(&mutexRouter);
+            return 0;
+        }
+        //El cierre lo hace el hilo de relevo, que es el único que lee de los canales
+        canales[victima].cerrar = 1;
+        if (write(despertar[1], "c", 1) < 0) {
+            perror("write");
+        }
+        pthread_cond_wait(&condCanal, &mutexRouter);
+    }
+}
+
+// Entrega una respuesta al pipe del solicitante, con los mismos reintentos que el receptor
+static void enviarCliente(int pid, const char *mensaje) {
+    char pipeCliente[32];
+    snprintf(pipeCliente, sizeof(pipeCliente), "pipe_%d", pid);
+    int fd = -1, intentos = 5;
+    while (intentos-- > 0) {
+        fd = open(pipeCliente, O_WRONLY);
+        if (fd >= 0) break;
+        usleep(100000);
+    }
+    if (fd < 0) {
+        printf("No se pudo abrir el pipe %s\n", pipeCliente);
+        return;
+    }
+    if (write(fd, mensaje, strlen(mensaje) + 1) == -1) {
+        printf("Error al escribir en el pipe %s\n", pipeCliente);
+    }
+    close(fd);
+}
+
+// Guarda la respuesta del receptor b para el solicitante pid. Si era la única que se esperaba se
+// entrega tal cual; si faltan otras se guarda y con la última se combinan. Los avisos de reserva
+// (MARCA_AVISO) y lo que llegue sin operación pendiente se entregan directo
+static void agregarParte(int pid, int b, const char *respuesta, int medir) {
+    int bit = 1 << b;
+    //Un aviso puede llegar mientras el solicitante espera otra respuesta de ese receptor
+    if (strncmp(respuesta, MARCA_AVISO, strlen(MARCA_AVISO)) == 0) {
+        enviarCliente(pid, respuesta);
+        return;
+    }
+    pthread_mutex_lock(&mutexRouter);
+    struct Pendiente *p = buscarPendiente(pid);
+    if (!p || !(p->esperadas & bit) || (p->recibidas & bit)) {
+        pthread_mutex_unlock(&mutexRouter);
+        enviarCliente(pid, respuesta);
+        return;
+    }
+    if (medir) {
+        unsigned long long us = (unsigned long long)(ahoraNs() - p->tEnvio) / 1000;
+        atomic_fetch_add(&backends[b].respuestas, 1);
+        atomic_fetch_add(&backends[b].sumaUs, us);
+        unsigned long long max = atomic_load(&backends[b].maxUs);
+        while (us > max && !atomic_compare_exchange_weak(&backends[b].maxUs, &max, us));
+    }
+    p->recibidas |= bit;
+    if (!p->combinar) {
+        liberarPendiente(p);
+        pthread_mutex_unlock(&mutexRouter);
+        enviarCliente(pid, respuesta);
+        return;
+    }
+    p->partes[b] = strdup(respuesta);
+    if (p->recibidas != p->esperadas) {
+        pthread_mutex_unlock(&mutexRouter);
+        return;
+    }
+    char *combinada = malloc(MAX_RESPUESTA_LOTE);
+    if (combinada) {
+        combinarRespuestas(p, combinada, MAX_RESPUESTA_LOTE);
+    }
+    liberarPendiente(p);
+    pthread_mutex_unlock(&mutexRouter);
+    if (combinada) {
+        enviarCliente(pid, combinada);
+        free(combinada);
+    }
+}
+
+// Recibe una trama que un receptor escribió en el canal id
+void recibirParte(int id, const char *respuesta) {
+    agregarParte(PID_DE_ID(id), BACKEND_DE_ID(id), respuesta, 1);
+}
+
+// Arma una sola respuesta con las partes de todos los receptores, con el mismo formato que daría
+// un receptor solo. Debe llamarse con mutexRouter tomado
+void combinarRespuestas(struct Pendiente *p, char *salida, size_t tam) {
+    int largo = 0;
+    if (p->tipo == 'M') {
+        //Cada parte es "M,k" y una línea por operación; se vuelven a poner en el orden del lote
+        char *lineas[MAX_BACKENDS][MAX_LOTE];
+        int cont[MAX_BACKENDS] = {0}, usadas[MAX_BACKENDS] = {0};
+        for (int b = 0; b < MAX_BACKENDS; b++) {
+            if (!p->partes[b]) continue;
+            if (strncmp(p->partes[b], "M,", 2) != 0) {
+                //El receptor no contestó un lote, su mensaje vale para todas sus operaciones
+                for (int k = 0; k < MAX_LOTE; k++) lineas[b][k] = p->partes[b];
+                cont[b] = MAX_LOTE;
+                continue;
+            }
+            char *guardado;
+            strtok_r(p->partes[b], "\n", &guardado);
+            for (char *linea = strtok_r(NULL, "\n", &guardado); linea && cont[b] < MAX_LOTE; linea = strtok_r(NULL, "\n", &guardado)) {
+                lineas[b][cont[b]++] = linea;
+            }
+        }
+        largo = snprintf(salida, tam, "M,%d", p->num);
+        for (int k = 0; k < p->num && largo < (int)tam; k++) {
+            int b = p->backendOp[k];
+            const char *linea = "Error: ISBN sin receptor asignado";
+            if (b >= 0) {
+                linea = usadas[b] < cont[b] ? lineas[b][usadas[b]++] : "Error: Sin respuesta del receptor";
+            }
+            largo += snprintf(salida + largo, tam - largo, "\n%s", linea);
+        }
+        return;
+    }
+
+    //B y L: se suman los totales de la primera línea de cada parte y se juntan las demás líneas
+    char *cuerpo = malloc(tam);
+    if (!cuerpo) {
+        snprintf(salida, tam, "Error: Sin memoria en el router");
+        return;
+    }
+    char prefijo[300];
+    if (p->tipo == 'B') {
+        snprintf(prefijo, sizeof(prefijo), "Resultados para \"%s\": ", p->nombre);
+    } else {
+        snprintf(prefijo, sizeof(prefijo), "Préstamos del solicitante ");
+    }
+    //En L cada receptor pone el prestatario (el cliente de s= o el pid que le llegó); se usa el que traigan
+    int total = 0, paginas = 0, largoCuerpo = 0, prestatario = p->pid;
+    cuerpo[0] = '\0';
+    //Si la operación traía s=cliente:sesion:secuencia cada parte empieza con "s=secuencia"; va una
+    //sola vez
+    char marca[32] = "";
+    for (int b = 0; b < MAX_BACKENDS; b++) {
+        if (!p->partes[b]) continue;
+        char *parte = p->partes[b];
+        char *finMarca = strchr(parte, '\n');
+        if (strncmp(parte, "s=", 2) == 0 && finMarca) {
+            snprintf(marca, sizeof(marca), "%.*s\n", (int)(finMarca - parte), parte);
+            parte = finMarca + 1;
+        }
+        char *resto = strchr(parte, '\n');
+        int n = 0, pags = 0;
+        int valido = strncmp(parte, prefijo, strlen(prefijo)) == 0;
+        if (valido && p->tipo == 'B') {
+            valido = sscanf(parte + strlen(prefijo), "%d (página %*d de %d)", &n, &pags) == 2;
+        } else if (valido) {
+            valido = sscanf(parte + strlen(prefijo), "%d: %d", &prestatario, &n) == 2;
+        }
+        if (!valido) {
+            //Un error de un receptor se pasa como una línea más
+            resto = parte;
+            largoCuerpo += snprintf(cuerpo + largoCuerpo, tam - largoCuerpo, "\n");
+        }
+        total += n;
+        if (pags > paginas) paginas = pags;
+        if (resto && largoCuerpo < (int)tam) {
+            largoCuerpo += snprintf(cuerpo + largoCuerpo, tam - largoCuerpo, "%s", resto);
+        }
+    }
+    if (p->tipo == 'B') {
+        largo = snprintf(salida, tam, "%s%s%d (página %d de %d)", marca, prefijo, total, p->pagina > 0 ? p->pagina : 1, paginas);
+    } else {
+        largo = snprintf(salida, tam, "%s%s%d: %d", marca, prefijo, prestatario, total);
+    }
+    if (largo < (int)tam) {
+        snprintf(salida + largo, tam - largo, "%s", cuerpo);
+    }
+    free(cuerpo);
+}
+
+// Escribe una trama en el pipe de un receptor y cuenta sus operaciones. Si falla, la respuesta
+// de ese receptor queda como un error para que el solicitante no se quede esperando
+static void reenviar(int b, int pid, const char *trama, int largo, int operaciones) {
+    if (verbose) {
+        printf("Reenviado a %s: %.60s\n", backends[b].pipe, trama);
+    }
+    if (write(backends[b].fd, trama, largo + 1) == -1) {
+        atomic_fetch_add(&backends[b].fallos, 1);
+        agregarParte(pid, b, "Error: No se pudo enviar la operación al receptor", 0);
+        return;
+    }
+    atomic_fetch_add(&backends[b].tramas, 1);
+    atomic_fetch_add(&backends[b].operaciones, operaciones);
+}
+
+// Reparte una operación suelta "tipo,nombre,isbn,pid[,opcionales]". P, R, D y C van al receptor
+// de su ISBN; B y L van a todos porque cada uno tiene solo una parte del catálogo
+void enrutarOperacion(char *trama) {
+    char tipo;
+    char nombre[250];
+    int isbn, pid, fin = 0;
+    if (sscanf(trama, "%c,%249[^,],%d,%d%n", &tipo, nombre, &isbn, &pid, &fin) != 4 || pid <= 0 || pid >= ID_BASE_ROUTER) {
+        printf("Formato inválido recibido: %.60s\n", trama);
+        return;
+    }
+    const char *opcionales = trama + fin;
+
+    //Q termina el router y se reenvía para que también terminen los receptores
+    if (tipo == 'Q') {
+        for (int b = 0; b < numBackends; b++) {
+            if (write(backends[b].fd, trama, strlen(trama) + 1) == -1) {
+                atomic_fetch_add(&backends[b].fallos, 1);
+            }
+        }
+        terminar = 1;
+        return;
+    }
+
+    int esperadas = 0, combinar = 0;
+    if (tipo == 'B' || tipo == 'L') {
+        esperadas = (1 << numBackends) - 1;
+        // L siempre se combina porque la respuesta trae el identificador del router
+        combinar = 1;
+    } else {
+        int b = backendDeIsbn(isbn);
+        if (b < 0) {
+            char respuesta[128];
+            snprintf(respuesta, sizeof(respuesta), "Error: ISBN %d sin receptor asignado", isbn);
+            enviarCliente(pid, respuesta);
+            return;
+        }
+        esperadas = 1 << b;
+    }
+    if (!registrarPendiente(pid, tipo, nombre, isbn, esperadas, combinar)) {
+        enviarCliente(pid, "Error: Router sin capacidad para más operaciones pendientes");
+        return;
+    }
+
+    for (int b = 0; b < numBackends; b++) {
+        if (!(esperadas & (1 << b))) continue;
+        if (!abrirCanal(pid, b)) {
+            atomic_fetch_add(&backends[b].fallos, 1);
+            agregarParte(pid, b, "Error: El router no pudo abrir el pipe de respuesta", 0);
+            continue;
+        }
+        char mensaje[2 * PIPE_BUF];
+        int largo = snprintf(mensaje, sizeof(mensaje), "%c,%s,%d,%d%s", tipo, nombre, isbn, ID_ROUTER(pid, b), opcionales);
+        reenviar(b, pid, mensaje, largo, 1);
+    }
+}
+
+// Reparte un lote "M,n,pid[,opcionales]" con una línea por operación. Las operaciones se
+// agrupan en un lote por receptor y las respuestas se vuelven a unir en el orden original
+void enrutarLote(char *trama) {
+    int num, pid, fin = 0;
+    char *finLinea = strchr(trama, '\n');
+    if (sscanf(trama, "M,%d,%d%n", &num, &pid, &fin) != 2 || num < 1 || num > MAX_LOTE || pid <= 0 ||
+        pid >= ID_BASE_ROUTER || !finLinea) {
+        printf("Lote inválido recibido: %.60s\n", trama);
+        return;
+    }
+    char opcionales[256];
+    snprintf(opcionales, sizeof(opcionales), "%.*s", (int)(finLinea - trama - fin), trama + fin);
+
+    char *lineas[MAX_LOTE];
+    int backendOp[MAX_LOTE];
+    int k = 0, esperadas = 0, combinar = 0;
+    char *guardado;
+    for (char *linea = strtok_r(finLinea + 1, "\n", &guardado); linea && k < num; linea = strtok_r(NULL, "\n", &guardado)) {
+        char tipo;
+        char nombre[250];
+        int isbn;
+        if (sscanf(linea, "%c,%249[^,],%d", &tipo, nombre, &isbn) != 3) {
+            printf("Lote inválido recibido: %.60s\n", linea);
+            return;
+        }
+        lineas[k] = linea;
+        backendOp[k] = backendDeIsbn(isbn);
+        if (backendOp[k] < 0) {
+            combinar = 1;
+        } else {
+            esperadas |= 1 << backendOp[k];
+        }
+        k++;
+    }
+    if (k != num) {
+        printf("Lote inválido recibido: faltan operaciones\n");
+        return;
+    }
+    //Si el lote va a más de un receptor o trae ISBN sin receptor, las respuestas se combinan
+    if (esperadas & (esperadas - 1)) {
+        combinar = 1;
+    }
+    if (esperadas == 0) {
+        char respuesta[MAX_RESPUESTA_LOTE];
+        int largo = snprintf(respuesta, sizeof(respuesta), "M,%d", num);
+        for (int i = 0; i < num && largo < (int)sizeof(respuesta); i++) {
+            largo += snprintf(respuesta + largo, sizeof(respuesta) - largo, "\nError: ISBN sin receptor asignado");
+        }
+        enviarCliente(pid, respuesta);
+        return;
+    }
+    struct Pendiente *p = registrarPendiente(pid, 'M', "", 0, esperadas, combinar);
+    if (!p) {
+        enviarCliente(pid, "Error: Router sin capacidad para más operaciones pendientes");
+        return;
+    }
+    pthread_mutex_lock(&mutexRouter);
+    p->num = num;
+    memcpy(p->backendOp, backendOp, sizeof(int) * num);
+    pthread_mutex_unlock(&mutexRouter);
+
+    for (int b = 0; b < numBackends; b++) {
+        if (!(esperadas & (1 << b))) continue;
+        if (!abrirCanal(pid, b)) {
+            atomic_fetch_add(&backends[b].fallos, 1);
+            agregarParte(pid, b, "Error: El router no pudo abrir el pipe de respuesta", 0);
+            continue;
+        }
+        int cuantas = 0;
+        for (int i = 0; i < num; i++) {
+            cuantas += backendOp[i] == b;
+        }
+        char mensaje[2 * PIPE_BUF];
+        int largo = snprintf(mensaje, sizeof(mensaje), "M,%d,%d%s", cuantas, ID_ROUTER(pid, b), opcionales);
+        for (int i = 0; i < num && largo < (int)sizeof(mensaje); i++) {
+            if (backendOp[i] == b) {
+                largo += snprintf(mensaje + largo, sizeof(mensaje) - largo, "\n%s", lineas[i]);
+            }
+        }
+        reenviar(b, pid, mensaje, largo, cuantas);
+    }
+}
+
+// Extrae del pipe principal la siguiente trama terminada en '\0', guardando lo que sobre para la
+// siguiente llamada igual que el receptor. Devuelve el largo de la trama o -1 si no hay datos
+static int siguienteTramaRouter(int fd, char *trama, int tam) {
+    static char pendiente[2 * PIPE_BUF];
+    static int lenPendiente = 0;
+    while (1) {
+        char *fin = memchr(pendiente, '\0', lenPendiente);
+        if (fin) {
+            int largo = fin - pendiente;
+            int copia = largo < tam - 1 ? largo : tam - 1;
+            memcpy(trama, pendiente, copia);
+            trama[copia] = '\0';
+            lenPendiente -= largo + 1;
+            memmove(pendiente, fin + 1, lenPendiente);
+            return copia;
+        }
+        if (lenPendiente == (int)sizeof(pendiente)) {
+            printf("Trama demasiado larga descartada\n");
+            lenPendiente = 0;
+        }
+        int bytes = read(fd, pendiente + lenPendiente, sizeof(pendiente) - lenPendiente);
+        if (bytes <= 0) {
+            return -1;
+        }
+        lenPendiente += bytes;
+    }
+}
+
+// Hilo que lee las respuestas de los receptores en todos los canales abiertos y las entrega.
+// También cierra los canales que el hilo principal marcó. Al terminar espera a que se respondan
+// las operaciones pendientes, como máximo ESPERA_CIERRE_MS
+void *relevo(void *args) {
+    struct pollfd fds[MAX_CANALES + 1];
+    int indices[MAX_CANALES + 1];
+    long long limite = 0;
+    while (1) {
+        pthread_mutex_lock(&mutexRouter);
+        int cerrados = 0;
+        for (int k = 0; k < MAX_CANALES; k++) {
+            if (canales[k].id != 0 && canales[k].cerrar) {
+                char nombre[32];
+                snprintf(nombre, sizeof(nombre), "pipe_%d", canales[k].id);
+                close(canales[k].fd);
+                unlink(nombre);
+                canales[k].id = 0;
+                canales[k].cerrar = 0;
+                cerrados = 1;
+            }
+        }
+        if (cerrados) {
+            pthread_cond_broadcast(&condCanal);
+        }
+        if (terminar) {
+            int hayPendientes = 0;
+            for (int k = 0; k < MAX_PENDIENTES; k++) {
+                hayPendientes |= pendientes[k].pid != 0;
+            }
+            if (limite == 0) limite = ahoraNs() + ESPERA_CIERRE_MS * 1000000LL;
+            if (!hayPendientes || ahoraNs() > limite) {
+                pthread_mutex_unlock(&mutexRouter);
+                break;
+            }
+        }
+        int n = 1;
+        fds[0].fd = despertar[0];
+        fds[0].events = POLLIN;
+        for (int k = 0; k < MAX_CANALES; k++) {
+            if (canales[k].id == 0) continue;
+            fds[n].fd = canales[k].fd;
+            fds[n].events = POLLIN;
+            indices[n++] = k;
+        }
+        pthread_mutex_unlock(&mutexRouter);
+
+        if (poll(fds, n, 100) <= 0) continue;
+        if (fds[0].revents & POLLIN) {
+            char basura[64];
+            if (read(despertar[0], basura, sizeof(basura)) < 0) {
+                perror("read");
+            }
+        }
+        for (int i = 1; i < n; i++) {
+            if (!(fds[i].revents & POLLIN)) continue;
+            //Solo este hilo toca los datos de los canales, así que se leen sin el mutex
+            struct Canal *canal = &canales[indices[i]];
+            if (canal->len == (int)sizeof(canal->datos)) {
+                printf("Respuesta demasiado larga descartada en pipe_%d\n", canal->id);
+                canal->len = 0;
+            }
+            int bytes = read(canal->fd, canal->datos + canal->len, sizeof(canal->datos) - canal->len);
+            if (bytes <= 0) continue;
+            canal->len += bytes;
+            char *fin;
+            while ((fin = memchr(canal->datos, '\0', canal->len)) != NULL) {
+                recibirParte(canal->id, canal->datos);
+                int usados = fin - canal->datos + 1;
+                canal->len -= usados;
+                memmove(canal->datos, fin + 1, canal->len);
+            }
+        }
+    }
+    return NULL;
+}
+
+// Escribe las estadísticas por receptor en formato de texto estilo Prometheus
+void imprimirEstadisticas(FILE *salida) {
+    fprintf(salida, "# TYPE router_tramas_total counter\n");
+    for (int b = 0; b < numBackends; b++) {
+        fprintf(salida, "router_tramas_total{backend=\"%s\"} %lu\n", backends[b].pipe, atomic_load(&backends[b].tramas));
+    }
+    fprintf(salida, "# TYPE router_operaciones_total counter\n");
+    for (int b = 0; b < numBackends; b++) {
+        fprintf(salida, "router_operaciones_total{backend=\"%s\"} %lu\n", backends[b].pipe, atomic_load(&backends[b].operaciones));
+    }
+    fprintf(salida, "# TYPE router_respuestas_total counter\n");
+    for (int b = 0; b < numBackends; b++) {
+        fprintf(salida, "router_respuestas_total{backend=\"%s\"} %lu\n", backends[b].pipe, atomic_load(&backends[b].respuestas));
+    }
+    fprintf(salida, "# TYPE router_fallos_total counter\n");
+    for (int b = 0; b < numBackends; b++) {
+        fprintf(salida, "router_fallos_total{backend=\"%s\"} %lu\n", backends[b].pipe, atomic_load(&backends[b].fallos));
+    }
+    fprintf(salida, "# TYPE router_latencia_us_sum counter\n");
+    for (int b = 0; b < numBackends; b++) {
+        fprintf(salida, "router_latencia_us_sum{backend=\"%s\"} %llu\n", backends[b].pipe, atomic_load(&backends[b].sumaUs));
+    }
+    fprintf(salida, "# TYPE router_latencia_us_max gauge\n");
+    for (int b = 0; b < numBackends; b++) {
+        fprintf(salida, "router_latencia_us_max{backend=\"%s\"} %llu\n", backends[b].pipe, atomic_load(&backends[b].maxUs));
+    }
+}
+
+// Escribe las estadísticas en un archivo temporal y lo renombra para no dejarlo a medias
+void guardarEstadisticas(const char *fileStats) {
+    char temporal[300];
+    snprintf(temporal, sizeof(temporal), "%s.tmp", fileStats);
+    FILE *salida = fopen(temporal, "w");
+    if (!salida) {
+        printf("Error al crear el archivo de estadísticas %s\n", fileStats);
+        return;
+    }
+    imprimirEstadisticas(salida);
+    fclose(salida);
+    rename(temporal, fileStats);
+}
+
+//Maneja comandos interactivos del usuario (s para salir, m para estadísticas por receptor)
+void *consolaRouter(void *args) {
+    char comando[3];
+    while (1) {
+        if (scanf("%2s", comando) != 1) {
+            if (feof(stdin)) break;
+            while (getchar() != '\n');
+            printf("Entrada inválida, utilice 's' para salir o 'm' para estadísticas\n");
+            continue;
+        }
+        while (getchar() != '\n');
+        if (strcmp(comando, "s") == 0) {
+            terminar = 1;
+            break;
+        } else if (strcmp(comando, "m") == 0) {
+            imprimirEstadisticas(stdout);
+        } else {
+            printf("Comando no reconocido\n");
+        }
+    }
+    return NULL;
+}
+
+// Proceso principal. Lee las rutas, abre los receptores y reparte las tramas hasta recibir Q
+int main(int argc, char *argv[]) {
+    if (argc < 5 || argc > 8) {
+        printf("\n \t\tUse: $./router –p pipeReceptor –c filerutas [-e filestats] [-v]\n");
+        exit(1);
+    }
+    char *pipeRec = NULL;
+    char *fileRutas = NULL;
+    char *fileStats = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            pipeRec = argv[++i];
+        } else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) {
+            fileRutas = argv[++i];
+        } else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+            fileStats = argv[++i];
+        } else if (strcmp(argv[i], "-v") == 0) {
+            verbose = 1;
+        }
+    }
+    if (!pipeRec || !fileRutas) {
+        printf("\n \t\tUse: $./router –p pipeReceptor –c filerutas [-e filestats] [-v]\n");
+        exit(1);
+    }
+    if (!leerRutas(fileRutas) || !abrirBackends()) {
+        exit(1);
+    }
+    //Si un receptor se cae, write devuelve error en vez de matar al router
+    signal(SIGPIPE, SIG_IGN);
+    if (pipe(despertar) == -1) {
+        printf("Error al crear el pipe interno del router\n");
+        exit(1);
+    }
+
+    if (mkfifo(pipeRec, 0666) == -1 && errno != EEXIST) {
+        printf("Error al crear el pipe %s\n", pipeRec);
+        exit(1);
+    }
+    int fd = open(pipeRec, O_RDWR);
+    if (fd < 0) {
+        printf("Error al abrir el pipe %s\n", pipeRec);
+        exit(1);
+    }
+
+    pthread_t hiloRelevo, hiloConsola;
+    pthread_create(&hiloRelevo, NULL, relevo, NULL);
+    pthread_create(&hiloConsola, NULL, consolaRouter, NULL);
+
+    char trama[2 * PIPE_BUF];
+    while (!terminar) {
+        if (siguienteTramaRouter(fd, trama, sizeof(trama)) < 0) {
+            break;
+        }
+        if (trama[0] == 'M') {
+            enrutarLote(trama);
+        } else {
+            enrutarOperacion(trama);
+        }
+    }
+    terminar = 1;
+    if (write(despertar[1], "t", 1) < 0) {
+        perror("write");
+    }
+
+    pthread_join(hiloRelevo, NULL);
+    pthread_join(hiloConsola, NULL);
+    close(fd);
+
+    //Se cierran y borran los pipes de respuesta que quedaron abiertos
+    for (int k = 0; k < MAX_CANALES; k++) {
+        if (canales[k].id == 0) continue;
+        char nombre[32];
+        snprintf(nombre, sizeof(nombre), "pipe_%d", canales[k].id);
+        close(canales[k].fd);
+        unlink(nombre);
+    }
+    for (int k = 0; k < MAX_PENDIENTES; k++) {
+        liberarPendiente(&pendientes[k]);
+    }
+    for (int b = 0; b < numBackends; b++) {
+        close(backends[b].fd);
+    }
+    imprimirEstadisticas(stdout);
+    if (fileStats) {
+        guardarEstadisticas(fileStats);
+    }
+    close(despertar[0]);
+    close(despertar[1]);
+    unlink(pipeRec);
+    return 0;
+}
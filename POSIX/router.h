@@ -0,0 +1,96 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: router.h
+#	Descripcion: Archivo de encabezado para router.c.
+#                Define los receptores de respaldo, las reglas de reparto por ISBN, los canales de
+#                respuesta y las operaciones que esperan respuesta de uno o varios receptores
+#****************************************************************/
+
+#ifndef ROUTER_H
+#define ROUTER_H
+
+#include <stdio.h>
+#include <stdatomic.h>
+#include "receptor.h"
+
+#define MAX_BACKENDS 8
+#define MAX_RANGOS 64
+#define MAX_CANALES 256
+#define MAX_PENDIENTES 128
+#define ESPERA_CIERRE_MS 2000
+
+// El router cambia el pid de cada trama por un identificador propio por solicitante y receptor.
+// Así el receptor responde a un pipe del router y los préstamos de cada solicitante siguen
+// quedando a un mismo nombre. Los identificadores son mayores que cualquier pid de Linux
+// (PID_MAX_LIMIT es 2^22) para que su pipe no choque con el de un solicitante real
+#define ID_BASE_ROUTER (1 << 23)
+#define ID_ROUTER(pid, b) (ID_BASE_ROUTER + (pid) * MAX_BACKENDS + (b))
+#define PID_DE_ID(id) (((id) - ID_BASE_ROUTER) / MAX_BACKENDS)
+#define BACKEND_DE_ID(id) (((id) - ID_BASE_ROUTER) % MAX_BACKENDS)
+
+// Receptor de respaldo y sus estadísticas. Solo el hilo principal escribe tramas y operaciones;
+// respuestas y latencias las suma el hilo de relevo
+struct Backend {
+    char pipe[256];
+    int fd;
+    int porHash; // 1 si entra al reparto por hash de los ISBN que no caen en ningún rango
+    atomic_ulong tramas;
+    atomic_ulong operaciones;
+    atomic_ulong respuestas;
+    atomic_ulong fallos;
+    atomic_ullong sumaUs;
+    atomic_ullong maxUs;
+};
+
+// Rango de ISBN [desde, hasta] asignado a un receptor
+struct Rango {
+    int desde;
+    int hasta;
+    int backend;
+};
+
+// Pipe por el que un receptor responde a un solicitante a través del router
+struct Canal {
+    int id; // Identificador del router (ID_ROUTER), 0 si la casilla está libre
+    int fd;
+    int cerrar; // El hilo principal lo marca y el de relevo lo cierra, así nunca se cierra mientras se espera en poll
+    long long usado;
+    int len;
+    char datos[MAX_RESPUESTA_LOTE];
+};
+
+// Operación de un solicitante que espera respuesta. Si la contestan varios receptores (B, L o un
+// lote repartido) las partes se guardan hasta tenerlas todas y se combinan en una sola respuesta
+struct Pendiente {
+    int pid; // 0 si la casilla está libre
+    char tipo;
+    char nombre[250];
+    int pagina;
+    int esperadas; // Bit por receptor que debe responder
+    int recibidas;
+    int combinar; // 0 si la única respuesta se entrega tal cual
+    int num;
+    int backendOp[MAX_LOTE]; // Receptor de cada operación del lote, en el orden original
+    long long tEnvio;
+    char *partes[MAX_BACKENDS];
+};
+
+// Funciones del router
+int leerRutas(const char *archivo);
+int backendDeIsbn(int isbn);
+int abrirBackends(void);
+int abrirCanal(int pid, int b);
+void enrutarOperacion(char *trama);
+void enrutarLote(char *trama);
+void recibirParte(int id, const char *respuesta);
+void combinarRespuestas(struct Pendiente *p, char *salida, size_t tam);
+void *relevo(void *args);
+void *consolaRouter(void *args);
+void imprimirEstadisticas(FILE *salida);
+void guardarEstadisticas(const char *fileStats);
+
+#endif
@@ -17,40 +17,319 @@
 #include <fcntl.h>
 #include <sys/stat.h>
 #include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <time.h>
 #include "solicitante.h"
+#include "codigos.h"
 
-// Función para leer respuestas del pipe (usada por ambas funciones)
-void leerRespuesta(int fdResp, const char *pipeRecibe, char tipo, int isbn) {
-    //Char para almacenar la respuesta junto al total de intentos para abrir el pipe
-    char respuesta[256];
+// Si es 1, los préstamos se mandan con r=1 para quedar en lista de espera cuando no hay ejemplar
+int reservar = 0;
+// Biblioteca a la que van las operaciones (-l); si es NULL el receptor usa la primera que cargó
+char *biblioteca = NULL;
+// Milisegundos que se espera cada respuesta antes de reenviar la operación (-e); con 0 se espera sin límite
+int esperaRespuesta = 0;
+// Identificador del solicitante en el campo s=cliente:sesion:secuencia (-k, por defecto el pid), la
+// sesión de esta ejecución y la última secuencia usada. Un reenvío lleva la misma secuencia, así el
+// receptor no lo aplica dos veces; la sesión cambia en cada ejecución, así un solicitante que se
+// reinicia con el mismo -k no recibe las respuestas guardadas de la ejecución anterior
+static int cliente = 0;
+static int sesion = 0;
+static int secuencia = 0;
+
+// Lee el campo k de una respuesta compacta: BYTES_CAMPO bytes de 7 bits, los más altos primero
+static int campoCompacto(const char *linea, int k) {
+    const unsigned char *p = (const unsigned char *)linea + 2 + k * BYTES_CAMPO;
+    int valor = 0;
+    for (int b = 0; b < BYTES_CAMPO; b++) {
+        valor = valor << 7 | (p[b] & 0x7F);
+    }
+    return valor;
+}
+
+// Arma el texto en español de una respuesta compacta del receptor (codigos.h). Las fechas llegan
+// como aaaammdd y se muestran dd-mm-aaaa. Devuelve los bytes escritos
+static int textoCompacto(const char *linea, char *texto, int tam) {
+    int isbn = campoCompacto(linea, 0), a = campoCompacto(linea, 1), b = campoCompacto(linea, 2), c = campoCompacto(linea, 3);
+    char fecha[16];
+    int dia = linea[1] == RESP_CONSULTA ? c : b;
+    snprintf(fecha, sizeof(fecha), "%02d-%02d-%04d", dia % 100, dia / 100 % 100, dia / 10000);
+    int largo;
+    switch (linea[1]) {
+    case RESP_PRESTAMO:
+        largo = snprintf(texto, tam, "Préstamo exitoso: ISBN %d, Ejemplar %d, entrega %s", isbn, a, fecha);
+        break;
+    case RESP_DEVOLUCION:
+        largo = snprintf(texto, tam, "Devolución exitosa: ISBN %d, Ejemplar %d", isbn, a);
+        break;
+    case RESP_RENOVACION:
+        largo = snprintf(texto, tam, "Renovación exitosa: ISBN %d, Ejemplar %d, nueva entrega %s", isbn, a, fecha);
+        break;
+    case RESP_EN_ESPERA:
+        largo = snprintf(texto, tam, "En espera: ISBN %d, posición %d", isbn, a);
+        break;
+    case RESP_RESERVA_ASIGNADA:
+        largo = snprintf(texto, tam, "Reserva asignada: ISBN %d, Ejemplar %d, entrega %s", isbn, a, fecha);
+        break;
+    case RESP_RESERVA_CANCELADA:
+        largo = snprintf(texto, tam, "Reserva cancelada: ISBN %d, el receptor terminó", isbn);
+        break;
+    case RESP_CONSULTA:
+        largo = snprintf(texto, tam, "Consulta ISBN %d: %d disponibles, %d prestados", isbn, a, b);
+        if (c != 0 && largo < tam) {
+            largo += snprintf(texto + largo, tam - largo, ", próxima entrega %s", fecha);
+        }
+        break;
+    case RESP_OCUPADO:
+        largo = snprintf(texto, tam, "Ocupado: reintente en %d ms", a);
+        break;
+    case RESP_ERROR_NO_ENCONTRADO:
+        largo = snprintf(texto, tam, "Error: ISBN %d no encontrado o nombre erróneo", isbn);
+        break;
+    case RESP_ERROR_SIN_EJEMPLAR:
+        largo = snprintf(texto, tam, "Error: No se encontró un ejemplar disponible para ISBN %d", isbn);
+        break;
+    case RESP_ERROR_SIN_PRESTAMO:
+        largo = snprintf(texto, tam, "Error: No se encontró un ejemplar prestado para ISBN %d", isbn);
+        break;
+    case RESP_ERROR_YA_RESERVADO:
+        largo = snprintf(texto, tam, "Error: Ya tiene una reserva para ISBN %d", isbn);
+        break;
+    case RESP_ERROR_LISTA_LLENA:
+        largo = snprintf(texto, tam, "Error: La lista de espera para ISBN %d está llena", isbn);
+        break;
+    case RESP_ERROR_BIBLIOTECA:
+        largo = snprintf(texto, tam, "Error: Biblioteca no encontrada");
+        break;
+    case RESP_ERROR_ISBN:
+        largo = snprintf(texto, tam, "Error: ISBN %d no encontrado", isbn);
+        break;
+    case RESP_ERROR_EN_LOTE:
+        largo = snprintf(texto, tam, "Error: operación %c no permitida en un lote", a);
+        break;
+    case RESP_ERROR_NO_SOPORTADA:
+        largo = snprintf(texto, tam, "Error: operación %c no soportada por este receptor", a);
+        break;
+    default:
+        largo = snprintf(texto, tam, "Respuesta desconocida del receptor (código %d)", linea[1]);
+        break;
+    }
+    return largo < tam ? largo : tam - 1;
+}
+
+// Pasa una trama del receptor a texto, línea por línea: las compactas se traducen con textoCompacto
+// y las de texto (búsquedas, listas de préstamos, cabecera de un lote, errores del router) se copian
+void traducirRespuesta(const char *trama, char *respuesta, int tam) {
+    int largo = 0;
+    while (largo < tam - 1) {
+        const char *fin = strchr(trama, '\n');
+        int largoLinea = fin ? fin - trama : (int)strlen(trama);
+        if (largoLinea == LARGO_COMPACTA && trama[0] == MARCA_COMPACTA) {
+            largo += textoCompacto(trama, respuesta + largo, tam - largo);
+        } else {
+            int copia = largoLinea < tam - 1 - largo ? largoLinea : tam - 1 - largo;
+            memcpy(respuesta + largo, trama, copia);
+            largo += copia;
+        }
+        if (!fin || largo >= tam - 1) break;
+        respuesta[largo++] = '\n';
+        trama = fin + 1;
+    }
+    respuesta[largo] = '\0';
+}
+
+// Lee del pipe de respuesta una trama completa (terminada en '\0') y la deja como texto. Devuelve 1 si la recibió,
+// -1 si pasaron esperaMs milisegundos sin datos (con 0 espera sin límite) y 0 si falló.
+// Lo que llegue después del '\0' se guarda para la siguiente llamada, porque un aviso de reserva
+// puede llegar pegado a otra respuesta en el mismo read
+int recibirRespuesta(int fdResp, const char *pipeRecibe, char *respuesta, int tam, int esperaMs) {
+    static char pendiente[2 * MAX_RESPUESTA_LOTE];
+    static int largoPendiente = 0;
+    //Total de intentos para recibir la respuesta completa
     int intentos = 10;
-    int total_bytes = 0;
 
-    //Da 10 intentos al pipe para abrirse
-    while (intentos-- > 0) {
-        //Se lee el pipe de respuesta y se imprime lo recibido
-        int bytes = read(fdResp, respuesta + total_bytes, sizeof(respuesta) - 1 - total_bytes);
-        if (bytes > 0) {
-            total_bytes += bytes;
-            if (respuesta[total_bytes - 1] == '\0') { // Mensaje completo recibido
-                printf("Respuesta del receptor para operación %c, ISBN %d: %s\n", tipo, isbn, respuesta);
-                return;
+    while (1) {
+        //Si ya hay una trama completa guardada se entrega esa
+        char *fin = memchr(pendiente, '\0', largoPendiente);
+        if (fin) {
+            int largo = fin - pendiente + 1;
+            traducirRespuesta(pendiente, respuesta, tam);
+            memmove(pendiente, pendiente + largo, largoPendiente - largo);
+            largoPendiente -= largo;
+            return 1;
+        }
+        if (intentos-- <= 0 || largoPendiente == (int)sizeof(pendiente)) {
+            return 0;
+        }
+        //Con espera se revisa antes si llegó algo, para no quedarse bloqueado en el read
+        if (esperaMs > 0) {
+            struct pollfd pfd = {fdResp, POLLIN, 0};
+            if (poll(&pfd, 1, esperaMs) == 0) {
+                return -1;
             }
+        }
+        //Se lee el pipe de respuesta
+        int bytes = read(fdResp, pendiente + largoPendiente, sizeof(pendiente) - largoPendiente);
+        if (bytes > 0) {
+            largoPendiente += bytes;
         } else if (bytes == 0) {
             // Fin (pipe cerrado por el otro extremo)
             printf("El pipe de respuesta %s fue cerrado por el receptor\n", pipeRecibe);
-            return;
+            return 0;
         } else {
             printf("Error al leer el pipe de respuesta \n");
-            return;
+            return 0;
+        }
+    }
+}
+
+// Arma la trama de una operación; los préstamos llevan r=1 si se pidió reservar y todas
+// llevan b=biblioteca si se eligió una con -l
+static int armarMensaje(char *mensaje, size_t tam, struct Operaciones *op, pid_t pid) {
+    int largo = snprintf(mensaje, tam, "%c,%s,%d,%d%s", op->tipo, op->nombre, op->isbn, pid, reservar && op->tipo == 'P' ? ",r=1" : "");
+    if (biblioteca) {
+        largo += snprintf(mensaje + largo, tam - largo, ",b=%s", biblioteca);
+    }
+    return largo;
+}
+
+// Si la respuesta es un aviso de reserva (empieza con MARCA_AVISO) le quita la marca y lo muestra.
+// Devuelve 1 si era un aviso
+static int mostrarAviso(char *respuesta) {
+    int largoMarca = strlen(MARCA_AVISO);
+    if (strncmp(respuesta, MARCA_AVISO, largoMarca) != 0) {
+        return 0;
+    }
+    memmove(respuesta, respuesta + largoMarca, strlen(respuesta + largoMarca) + 1);
+    printf("Aviso del receptor: %s\n", respuesta);
+    return 1;
+}
+
+// Función para leer respuestas del pipe (usada por ambas funciones). Si el receptor contestó que
+// está ocupado devuelve los milisegundos que pidió esperar antes de reintentar, -1 si la respuesta
+// no llegó en la espera de -e y si no 0. Las respuestas que empiezan con "s=n" de otra secuencia
+// son de un envío anterior que ya se abandonó y se descartan; los avisos de reserva ("s=0") se
+// muestran y se sigue esperando
+int leerRespuesta(int fdResp, const char *pipeRecibe, char tipo, int isbn, int secuencia) {
+    //Char para almacenar la respuesta
+    char respuesta[MAX_RESPUESTA_LOTE];
+    int recibida;
+    while ((recibida = recibirRespuesta(fdResp, pipeRecibe, respuesta, sizeof(respuesta), esperaRespuesta)) == 1) {
+        if (mostrarAviso(respuesta)) {
+            continue;
+        }
+        int marca, largoMarca = 0;
+        if (sscanf(respuesta, "s=%d\n%n", &marca, &largoMarca) != 1 || largoMarca == 0) {
+            break;
+        }
+        if (marca == secuencia) {
+            memmove(respuesta, respuesta + largoMarca, strlen(respuesta + largoMarca) + 1);
+            break;
+        }
+        printf("Se descarta una respuesta atrasada (secuencia %d) para la operación %c, ISBN %d\n", marca, tipo, isbn);
+    }
+    if (recibida < 0) {
+        return -1;
+    }
+    if (recibida) {
+        int espera;
+        if (sscanf(respuesta, "Ocupado: reintente en %d ms", &espera) == 1) {
+            return espera > 0 ? espera : 1;
         }
-        usleep(100000); // Esperar 100ms antes de reintentar
+        printf("Respuesta del receptor para operación %c, ISBN %d: %s\n", tipo, isbn, respuesta);
+        //Si el préstamo quedó en espera, se bloquea hasta que el receptor avise la asignación en vez de reintentar
+        if (strncmp(respuesta, "En espera", 9) == 0) {
+            printf("Esperando a que se devuelva un ejemplar de ISBN %d...\n", isbn);
+            if (recibirRespuesta(fdResp, pipeRecibe, respuesta, sizeof(respuesta), 0) == 1 && !mostrarAviso(respuesta)) {
+                printf("Aviso del receptor para ISBN %d: %s\n", isbn, respuesta);
+            }
+        }
+        return 0;
     }
     printf("No se recibió respuesta para la operación %c, ISBN %d después de varios intentos\n", tipo, isbn);
+    return 0;
+}
+
+// Manda una operación y muestra su respuesta. Si el receptor está ocupado espera lo que pidió y la
+// vuelve a mandar, hasta MAX_REINTENTOS_OCUPADO veces. Con -e, si la respuesta no llega a tiempo se
+// reenvía hasta MAX_REINTENTOS_ESPERA veces con la misma secuencia, así un préstamo que sí se aplicó
+// no se vuelve a aplicar: el receptor contesta el reenvío con la respuesta que ya dio
+void enviarOperacion(int fd, pid_t pid, struct Operaciones *op, const char *pipeRecibe, int fdResp) {
+    char mensaje[256];
+    int largo = armarMensaje(mensaje, sizeof(mensaje), op, pid);
+    snprintf(mensaje + largo, sizeof(mensaje) - largo, ",s=%d:%d:%d", cliente, sesion, ++secuencia);
+    int ocupado = 0, sinRespuesta = 0;
+    while (1) {
+        write(fd, mensaje, strlen(mensaje) + 1);
+        int espera = leerRespuesta(fdResp, pipeRecibe, op->tipo, op->isbn, secuencia);
+        if (espera == 0) {
+            return;
+        }
+        if (espera < 0) {
+            if (++sinRespuesta > MAX_REINTENTOS_ESPERA) {
+                printf("No se recibió respuesta para la operación %c, ISBN %d después de %d reenvíos\n", op->tipo, op->isbn, MAX_REINTENTOS_ESPERA);
+                return;
+            }
+            printf("Sin respuesta en %d ms para la operación %c, ISBN %d: se reenvía\n", esperaRespuesta, op->tipo, op->isbn);
+            continue;
+        }
+        if (++ocupado > MAX_REINTENTOS_OCUPADO) {
+            printf("El receptor siguió ocupado para la operación %c, ISBN %d después de %d reintentos\n", op->tipo, op->isbn, MAX_REINTENTOS_OCUPADO);
+            return;
+        }
+        printf("Receptor ocupado para la operación %c, ISBN %d: se reintenta en %d ms\n", op->tipo, op->isbn, espera);
+        usleep(espera * 1000);
+    }
+}
+
+// Envía un lote de operaciones en una sola trama "M,n,pid[,b=id],s=cliente:sesion:0" con una línea por operación
+// y muestra la respuesta de cada una. Si el receptor o el planificador están ocupados responden al lote
+// con una sola línea "Ocupado": se espera lo que pidieron y se reenvía completo, hasta
+// MAX_REINTENTOS_OCUPADO veces, porque ninguna de sus operaciones se aplicó
+void enviarLote(int fd, pid_t pid, struct Operaciones *ops, int num, const char *pipeRecibe, int fdResp) {
+    char mensaje[PIPE_BUF];
+    int largo = snprintf(mensaje, sizeof(mensaje), "M,%d,%d", num, pid);
+    if (biblioteca) {
+        largo += snprintf(mensaje + largo, sizeof(mensaje) - largo, ",b=%s", biblioteca);
+    }
+    //El cliente va para que los préstamos queden a su nombre; con secuencia 0 el lote no se deduplica
+    largo += snprintf(mensaje + largo, sizeof(mensaje) - largo, ",s=%d:%d:0", cliente, sesion);
+    for (int k = 0; k < num; k++) {
+        largo += snprintf(mensaje + largo, sizeof(mensaje) - largo, "\n%c,%s,%d", ops[k].tipo, ops[k].nombre, ops[k].isbn);
+    }
+
+    //La respuesta trae "M,n" y una línea por operación, en el mismo orden. Los lotes no llevan
+    //secuencia, así que no se reenvían por -e y su respuesta se espera sin límite
+    char respuesta[MAX_RESPUESTA_LOTE];
+    int ocupado = 0;
+    while (1) {
+        write(fd, mensaje, largo + 1);
+        int recibida;
+        while ((recibida = recibirRespuesta(fdResp, pipeRecibe, respuesta, sizeof(respuesta), 0)) == 1 && mostrarAviso(respuesta));
+        if (recibida != 1) {
+            printf("No se recibió respuesta para el lote de %d operaciones después de varios intentos\n", num);
+            return;
+        }
+        int espera;
+        if (sscanf(respuesta, "Ocupado: reintente en %d ms", &espera) != 1) break;
+        if (++ocupado > MAX_REINTENTOS_OCUPADO) {
+            printf("El receptor siguió ocupado para el lote de %d operaciones después de %d reintentos\n", num, MAX_REINTENTOS_OCUPADO);
+            return;
+        }
+        printf("Receptor ocupado para el lote de %d operaciones: se reintenta en %d ms\n", num, espera);
+        usleep((espera > 0 ? espera : 1) * 1000);
+    }
+    char *linea = strchr(respuesta, '\n');
+    for (int k = 0; k < num && linea; k++) {
+        char *siguiente = strchr(linea + 1, '\n');
+        if (siguiente) *siguiente = '\0';
+        printf("Respuesta del receptor para operación %c, ISBN %d: %s\n", ops[k].tipo, ops[k].isbn, linea + 1);
+        linea = siguiente;
+    }
 }
 
 // Lee operaciones desde un archivo de texto y las envía al receptor
-void leerArchivo(char *nomArchivo, int fd, pid_t pid, const char *pipeRecibe, int fdResp) {
+void leerArchivo(char *nomArchivo, int fd, pid_t pid, const char *pipeRecibe, int fdResp, int tamLote) {
     //Se abre el archivo en modo lectura
     FILE *archivo = fopen(nomArchivo, "r");
     //Se verifica que el archivo haya sido leído exitosamente
@@ -63,6 +342,9 @@ void leerArchivo(char *nomArchivo, int fd, pid_t pid, const char *pipeRecibe, in
     //Char para almacenar línea
     char linea[256];
     int Qmandado = 0;
+    //Operaciones acumuladas para el siguiente lote (solo con -b mayor a 1)
+    struct Operaciones lote[MAX_LOTE];
+    int numLote = 0, largoLote = 0;
     // While que va hasta que no lea mas líneas en el archivo
     while (fgets(linea, sizeof(linea), archivo)) {
          //Ignorar líneas vacias
@@ -72,6 +354,11 @@ void leerArchivo(char *nomArchivo, int fd, pid_t pid, const char *pipeRecibe, in
         if (sscanf(linea, "%c, %249[^,], %d", &op.tipo, op.nombre, &op.isbn) == 3) {
             // Leer respuesta para la operación Q
             if (op.tipo == 'Q') {
+                //Antes de salir se manda lo que quede del lote
+                if (numLote > 0) {
+                    enviarLote(fd, pid, lote, numLote, pipeRecibe, fdResp);
+                    numLote = 0;
+                }
                 Qmandado = 1;
                 char mensaje[256];
                 //Se escribe el mensaje en el pipe
@@ -79,15 +366,35 @@ void leerArchivo(char *nomArchivo, int fd, pid_t pid, const char *pipeRecibe, in
                 write(fd, mensaje, strlen(mensaje) + 1);
                 break;
             }
-            //Se escribe el mensaje en el pipe y se llama a leer respuesta para esperar la respuesta de receptor
-            char mensaje[256];
-            snprintf(mensaje, sizeof(mensaje), "%c,%s,%d,%d", op.tipo, op.nombre, op.isbn, pid);
-            write(fd, mensaje, strlen(mensaje) + 1);
-            leerRespuesta(fdResp, pipeRecibe, op.tipo, op.isbn);
+            //En modo lote se acumula la operación; el lote se manda al llenarse o si ya no cabe en una escritura atómica.
+            //Las búsquedas (B) y las listas de préstamos (L) no van en lote porque su respuesta ocupa varias
+            //líneas, ni los préstamos con reserva porque pueden quedar esperando un aviso
+            if (tamLote > 1 && op.tipo != 'B' && op.tipo != 'L' && !(reservar && op.tipo == 'P')) {
+                int largo = strlen(op.nombre) + 20;
+                if (numLote > 0 && (numLote == tamLote || largoLote + largo >= PIPE_BUF)) {
+                    enviarLote(fd, pid, lote, numLote, pipeRecibe, fdResp);
+                    numLote = 0;
+                }
+                //El encabezado "M,n,pid,b=...,s=cliente:sesion:0" ocupa a lo sumo 64 bytes más la biblioteca
+                if (numLote == 0) largoLote = 64 + (biblioteca ? strlen(biblioteca) : 0);
+                lote[numLote++] = op;
+                largoLote += largo;
+                continue;
+            }
+            //Lo que quede del lote se manda antes, para respetar el orden del archivo
+            if (numLote > 0) {
+                enviarLote(fd, pid, lote, numLote, pipeRecibe, fdResp);
+                numLote = 0;
+            }
+            //Se escribe el mensaje en el pipe y se espera la respuesta del receptor, reintentando si está ocupado
+            enviarOperacion(fd, pid, &op, pipeRecibe, fdResp);
 
         } else {
             printf("Error al leer la línea: %s\n", linea);
         }
+    }
+    if (numLote > 0) {
+        enviarLote(fd, pid, lote, numLote, pipeRecibe, fdResp);
     }
      // Si no se mandó Q, preguntar al usuario si desea mandarlo
     if (!Qmandado) {
@@ -117,28 +424,26 @@ void menu(int fd, pid_t pid, const char *pipeRecibe, int fdResp) {
     while (continuar) {
         //Pedir al usuario que digite la información de la operación
         struct Operaciones op;
-        printf("Operación (D/R/P): ");
+        printf("Operación (D/R/P/B/C/L): ");
         scanf(" %c", &op.tipo);
 
-        printf("Nombre del libro: ");
+        //En la búsqueda se piden los términos y la página en lugar del nombre y el ISBN
+        printf(op.tipo == 'B' ? "Términos a buscar: " : "Nombre del libro: ");
         scanf(" %249[^\n]", op.nombre);
         while (getchar() != '\n');
 
-        printf("ISBN: ");
+        printf(op.tipo == 'B' ? "Página: " : "ISBN: ");
         scanf("%d", &op.isbn);
         while (getchar() != '\n');
 
-            //Se verifica que la operación que se haya digitado sea una de las 3 disponibles, de lo contrario se vuelve a preguntar
-        if (op.tipo != 'D' && op.tipo != 'R' && op.tipo != 'P') {
-            printf("Operación inválida. Debe ser D, R o P.\n");
+            //Se verifica que la operación que se haya digitado sea una de las 6 disponibles, de lo contrario se vuelve a preguntar
+        if (op.tipo != 'D' && op.tipo != 'R' && op.tipo != 'P' && op.tipo != 'B' && op.tipo != 'C' && op.tipo != 'L') {
+            printf("Operación inválida. Debe ser D, R, P, B, C o L.\n");
             continue;
         }
 
-        //Se manda el mensaje en el pipe y se llama a leer respuesta del receptor
-        char mensaje[256];
-        snprintf(mensaje, sizeof(mensaje), "%c,%s,%d,%d", op.tipo, op.nombre, op.isbn, pid);
-        write(fd, mensaje, strlen(mensaje) + 1);
-        leerRespuesta(fdResp, pipeRecibe, op.tipo, op.isbn);
+        //Se manda el mensaje en el pipe y se espera la respuesta del receptor, reintentando si está ocupado
+        enviarOperacion(fd, pid, &op, pipeRecibe, fdResp);
 
         //Verificación en caso de que el usuario quiera digitar más opciones o no
         int cont = -1;
@@ -164,13 +469,14 @@ void menu(int fd, pid_t pid, const char *pipeRecibe, int fdResp) {
 //Función principal del solicitante. Inicializa los pipes y ejecuta el modo interactivo o de archivo
 int main(int argc, char *argv[]) {
     //Se verifica el número de argumentos pasados, para ver si es válido o no
-    if (argc != 3 && argc != 5) {
-        printf("\n\tUse: $./solicitante [-i file] -p pipeReceptor\n");
+    if (argc < 3 || argc > 14) {
+        printf("\n\tUse: $./solicitante [-i file [-b tamLote]] [-r] [-l biblioteca] [-e esperaMs] [-k cliente] -p pipeReceptor\n");
         exit(1);
     }
     //Variables por si toca guardar datos según lo que se pase de argumento
     char *pipeRec = NULL;
     char *nomArchivo = NULL;
+    int tamLote = 1;
     
     //Recorre los argumentos y revisa que banderas hay y cuales no, guardando la información respectiva
     for (int i = 1; i < argc; i++) {
@@ -178,6 +484,16 @@ int main(int argc, char *argv[]) {
             pipeRec = argv[++i];
         } else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc) {
             nomArchivo = argv[++i];
+        } else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            tamLote = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0) {
+            reservar = 1;
+        } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+            biblioteca = argv[++i];
+        } else if (strcmp(argv[i], "-e") == 0 && i + 1 < argc) {
+            esperaRespuesta = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc) {
+            cliente = atoi(argv[++i]);
         }
     }
 
@@ -186,6 +502,14 @@ int main(int argc, char *argv[]) {
         printf("\n\tError: Debe especificar un pipe receptor con -p\n");
         exit(1);
     }
+    if (tamLote < 1 || tamLote > MAX_LOTE) {
+        printf("\n\tError: El tamaño de lote debe estar entre 1 y %d\n", MAX_LOTE);
+        exit(1);
+    }
+    if (esperaRespuesta < 0 || cliente < 0) {
+        printf("\n\tError: La espera (-e) y el cliente (-k) no pueden ser negativos\n");
+        exit(1);
+    }
 
     // Se intenta abrir el pipe en modo escritura
     int fd = open(pipeRec, O_WRONLY);
@@ -196,6 +520,15 @@ int main(int argc, char *argv[]) {
 
     //Se guarda el id del proceso para crear el pipe que recibe respuestas
     pid_t pid = getpid();
+    //Sin -k el solicitante se identifica en los reenvíos con su pid
+    if (cliente == 0) {
+        cliente = pid;
+    }
+    //La sesión sale del reloj y del pid: dos ejecuciones con el mismo -k no la repiten
+    struct timespec ahora;
+    clock_gettime(CLOCK_REALTIME, &ahora);
+    sesion = (int)(((unsigned)ahora.tv_sec * 2654435761u ^ (unsigned)ahora.tv_nsec ^ (unsigned)pid << 16) & 0x7FFFFFFF);
+    if (sesion == 0) sesion = 1;
     char pipeRecibe[20];
     snprintf(pipeRecibe, sizeof(pipeRecibe), "pipe_%d", pid);
 
@@ -218,7 +551,7 @@ int main(int argc, char *argv[]) {
     //Se verifica si se tiene nombre de archivo, si no, se manda al menú
 
     if (nomArchivo) {
-        leerArchivo(nomArchivo, fd, pid, pipeRecibe, fdResp);
+        leerArchivo(nomArchivo, fd, pid, pipeRecibe, fdResp, tamLote);
     } else {
         menu(fd, pid, pipeRecibe, fdResp);
     }
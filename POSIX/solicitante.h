@@ -12,6 +12,15 @@
 #ifndef SOLICITANTE_H
 #define SOLICITANTE_H
 
+#include <sys/types.h>
+
+#define MAX_LOTE 64
+#define MAX_RESPUESTA_LOTE 8192
+// Veces que se reenvía una operación a la que el receptor respondió que está ocupado
+#define MAX_REINTENTOS_OCUPADO 50
+// Veces que se reenvía una operación cuya respuesta no llegó en la espera dada con -e
+#define MAX_REINTENTOS_ESPERA 5
+
 // Estructura que representa una operación enviada al receptor.
 struct Operaciones {
     char tipo;
@@ -19,9 +28,16 @@ struct Operaciones {
     int isbn;
 };
 
+extern int reservar;
+extern int esperaRespuesta;
+
 // Funciones del solicitante
-void leerRespuesta(int fdResp, const char *pipeRecibe, char tipo, int isbn);
-void leerArchivo(char *nomArchivo, int fd, pid_t pid, const char *pipeRecibe, int fdResp);
+void traducirRespuesta(const char *trama, char *respuesta, int tam);
+int recibirRespuesta(int fdResp, const char *pipeRecibe, char *respuesta, int tam, int esperaMs);
+int leerRespuesta(int fdResp, const char *pipeRecibe, char tipo, int isbn, int secuencia);
+void enviarOperacion(int fd, pid_t pid, struct Operaciones *op, const char *pipeRecibe, int fdResp);
+void enviarLote(int fd, pid_t pid, struct Operaciones *ops, int num, const char *pipeRecibe, int fdResp);
+void leerArchivo(char *nomArchivo, int fd, pid_t pid, const char *pipeRecibe, int fdResp, int tamLote);
 void menu(int fd, pid_t pid, const char *pipeRecibe, int fdResp);
 
 #endif
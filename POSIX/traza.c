@@ -0,0 +1,175 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: traza.c
+#	Descripcion: Trazado por operación. Cada operación lleva sus marcas de tiempo monotónicas
+#                (lectura, parseo, encolado, desencolado, proceso, respuesta y escritura); las marcas
+#                viajan con la respuesta hasta el escritor, que al terminar de escribirla guarda el
+#                registro en su propio arreglo. Al final todo se exporta como JSON de Chrome
+#                trace-event, que se puede abrir en Perfetto (ui.perfetto.dev).
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include "metricas.h"
+#include "traza.h"
+
+// Operación ya respondida, lista para exportar
+struct RegistroTraza {
+    struct Traza traza;
+    char tipo;
+    int isbn;
+    int pid;
+    int hilo;
+};
+
+// Registros de un hilo; solo ese hilo escribe hasta que se exporta
+struct RegistrosHilo {
+    struct RegistroTraza *registros;
+    int num;
+    int capacidad;
+};
+
+int trazaActiva = 0;
+
+static struct RegistrosHilo *_Atomic hilosTraza[MAX_HILOS_TRAZA];
+static atomic_int numHilosTraza = 0;
+static __thread struct RegistrosHilo *registrosLocal = NULL;
+static __thread int idHilo = 0;
+static atomic_ulong trazasDescartadas = 0;
+
+// Identificador del hilo del sistema, para agrupar los eventos por hilo en el visor
+static int hiloActual(void) {
+    if (!idHilo) {
+        idHilo = (int)syscall(SYS_gettid);
+    }
+    return idHilo;
+}
+
+// Activa la toma de marcas
+void iniciarTraza(void) {
+    trazaActiva = 1;
+}
+
+// Marca la lectura con el mismo instante que usan las métricas y recuerda el hilo de ingreso
+void marcarIngreso(struct Traza *traza, long long tIngreso) {
+    if (!trazaActiva) return;
+    memset(traza, 0, sizeof(*traza));
+    traza->marcas[TRAZA_LEIDO] = tIngreso;
+    traza->hiloIngreso = hiloActual();
+}
+
+// Marca que la respuesta entra a la cola de salida y recuerda el hilo que procesó la operación
+void marcarRespuesta(struct Traza *traza) {
+    if (!trazaActiva) return;
+    traza->marcas[TRAZA_RESPONDIDO] = tiempoNs();
+    traza->hiloRespuesta = hiloActual();
+}
+
+// Guarda el registro de una operación respondida en el arreglo del hilo actual
+void registrarTraza(const struct Traza *traza, char tipo, int isbn, int pid) {
+    if (!trazaActiva) return;
+    if (!registrosLocal) {
+        int slot = atomic_fetch_add(&numHilosTraza, 1);
+        if (slot >= MAX_HILOS_TRAZA) {
+            atomic_fetch_add(&trazasDescartadas, 1);
+            return;
+        }
+        registrosLocal = calloc(1, sizeof(struct RegistrosHilo));
+        if (!registrosLocal) return;
+        atomic_store(&hilosTraza[slot], registrosLocal);
+    }
+    struct RegistrosHilo *r = registrosLocal;
+    if (r->num == r->capacidad) {
+        if (r->capacidad >= MAX_REGISTROS_TRAZA) {
+            atomic_fetch_add(&trazasDescartadas, 1);
+            return;
+        }
+        int nueva = r->capacidad ? r->capacidad * 2 : 1024;
+        struct RegistroTraza *registros = realloc(r->registros, sizeof(struct RegistroTraza) * nueva);
+        if (!registros) {
+            atomic_fetch_add(&trazasDescartadas, 1);
+            return;
+        }
+        r->registros = registros;
+        r->capacidad = nueva;
+    }
+    struct RegistroTraza *reg = &r->registros[r->num++];
+    reg->traza = *traza;
+    reg->tipo = tipo;
+    reg->isbn = isbn;
+    reg->pid = pid;
+    reg->hilo = hiloActual();
+}
+
+// Escribe un evento completo (ph X) si ambas marcas existen
+static void escribirTramo(FILE *f, int *primero, const char *nombre, const struct RegistroTraza *reg, int hilo, long long inicio, long long fin) {
+    if (inicio <= 0 || fin <= 0 || fin < inicio) return;
+    fprintf(f, "%s\n{\"name\":\"%s\",\"cat\":\"%c\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,"
+               "\"args\":{\"isbn\":%d,\"cliente\":%d}}",
+            *primero ? "" : ",", nombre, reg->tipo, hilo, inicio / 1000.0, (fin - inicio) / 1000.0, reg->isbn, reg->pid);
+    *primero = 0;
+}
+
+// Escribe un evento asíncrono (ph b/e) que puede empezar y terminar en hilos distintos
+static void escribirAsincrono(FILE *f, int *primero, const char *nombre, const struct RegistroTraza *reg, long id, long long inicio, long long fin) {
+    if (inicio <= 0 || fin <= 0 || fin < inicio) return;
+    fprintf(f, "%s\n{\"name\":\"%s\",\"cat\":\"%c\",\"ph\":\"b\",\"pid\":1,\"id\":%ld,\"ts\":%.3f,\"args\":{\"isbn\":%d,\"cliente\":%d}}",
+            *primero ? "" : ",", nombre, reg->tipo, id, inicio / 1000.0, reg->isbn, reg->pid);
+    fprintf(f, ",\n{\"name\":\"%s\",\"cat\":\"%c\",\"ph\":\"e\",\"pid\":1,\"id\":%ld,\"ts\":%.3f}",
+            nombre, reg->tipo, id, fin / 1000.0);
+    *primero = 0;
+}
+
+// Exporta todos los registros en formato Chrome trace-event. Se llama cuando ya no quedan hilos trabajando
+void guardarTraza(const char *fileTraza) {
+    if (!trazaActiva) return;
+    FILE *f = fopen(fileTraza, "w");
+    if (!f) {
+        printf("Error al crear el archivo de traza %s\n", fileTraza);
+        return;
+    }
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    int primero = 1;
+    long id = 0;
+    int hilos = atomic_load(&numHilosTraza);
+    if (hilos > MAX_HILOS_TRAZA) hilos = MAX_HILOS_TRAZA;
+    for (int h = 0; h < hilos; h++) {
+        struct RegistrosHilo *r = atomic_load(&hilosTraza[h]);
+        if (!r) continue;
+        for (int i = 0; i < r->num; i++) {
+            const struct RegistroTraza *reg = &r->registros[i];
+            const long long *m = reg->traza.marcas;
+            char nombre[32];
+            snprintf(nombre, sizeof(nombre), "operacion %c", reg->tipo);
+            id++;
+            // La operación completa y la espera en el buffer cruzan de hilo. Si la respuesta no
+            // llegó a escribirse la operación termina al encolarla
+            long long fin = m[TRAZA_ESCRITO] > 0 ? m[TRAZA_ESCRITO] : m[TRAZA_RESPONDIDO];
+            escribirAsincrono(f, &primero, nombre, reg, id, m[TRAZA_LEIDO], fin);
+            escribirAsincrono(f, &primero, "espera buffer", reg, id, m[TRAZA_ENCOLADO], m[TRAZA_DESENCOLADO]);
+            // Las fases propias de cada hilo
+            escribirTramo(f, &primero, "parseo", reg, reg->traza.hiloIngreso, m[TRAZA_LEIDO], m[TRAZA_PARSEADO]);
+            int hiloProceso = reg->traza.hiloRespuesta ? reg->traza.hiloRespuesta : reg->hilo;
+            long long inicioProceso = m[TRAZA_DESENCOLADO] > 0 ? m[TRAZA_DESENCOLADO] : m[TRAZA_PARSEADO];
+            escribirTramo(f, &primero, "catalogo", reg, hiloProceso, inicioProceso, m[TRAZA_PROCESADO]);
+            escribirTramo(f, &primero, "respuesta", reg, hiloProceso, m[TRAZA_PROCESADO], m[TRAZA_RESPONDIDO]);
+            // La espera en la cola de salida y la escritura van como asíncronas: con reaperturas y
+            // reintentos la escritura se intercala con las de otros solicitantes en el mismo escritor
+            escribirAsincrono(f, &primero, "cola salida", reg, id, m[TRAZA_RESPONDIDO], m[TRAZA_ESCRIBIENDO]);
+            escribirAsincrono(f, &primero, "escritura", reg, id, m[TRAZA_ESCRIBIENDO], m[TRAZA_ESCRITO]);
+        }
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    unsigned long descartadas = atomic_load(&trazasDescartadas);
+    if (descartadas > 0) {
+        printf("Traza: %lu operaciones sin registrar por falta de espacio\n", descartadas);
+    }
+}
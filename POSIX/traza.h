@@ -0,0 +1,56 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: traza.h
+#	Descripcion: Archivo de encabezado para traza.c.
+#                Define las marcas de tiempo por operación y la exportación en formato Chrome trace-event
+#****************************************************************/
+
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#include <stdatomic.h>
+
+// Registros máximos por hilo antes de empezar a descartar
+#define MAX_REGISTROS_TRAZA 500000
+#define MAX_HILOS_TRAZA 64
+
+// Momentos que se marcan en la vida de una operación
+enum MarcaTraza {
+    TRAZA_LEIDO,        // read() del pipe principal devolvió la operación
+    TRAZA_PARSEADO,     // se validó el formato
+    TRAZA_ENCOLADO,     // entró a su carril del buffer
+    TRAZA_DESENCOLADO,  // auxiliar1 la sacó del buffer
+    TRAZA_PROCESADO,    // se terminó de buscar/modificar el catálogo
+    TRAZA_RESPONDIDO,   // la respuesta entró a la cola de salida
+    TRAZA_ESCRIBIENDO,  // el escritor hizo el primer intento de abrir el pipe o escribirla
+    TRAZA_ESCRITO,      // la respuesta quedó escrita completa en el pipe del solicitante
+    NUM_MARCAS_TRAZA
+};
+
+// Marcas de una operación e hilos que la atendieron
+struct Traza {
+    long long marcas[NUM_MARCAS_TRAZA];
+    int hiloIngreso;
+    int hiloRespuesta; // Hilo que procesó la operación y encoló su respuesta
+};
+
+// Solo se toman marcas si se pidió -T; si no, el costo es una comparación
+extern int trazaActiva;
+
+#define MARCAR_TRAZA(traza, marca) \
+    do { \
+        if (__builtin_expect(trazaActiva, 0)) (traza)->marcas[(marca)] = tiempoNs(); \
+    } while (0)
+
+// Funciones de trazado
+void iniciarTraza(void);
+void marcarIngreso(struct Traza *traza, long long tIngreso);
+void marcarRespuesta(struct Traza *traza);
+void registrarTraza(const struct Traza *traza, char tipo, int isbn, int pid);
+void guardarTraza(const char *fileTraza);
+
+#endif
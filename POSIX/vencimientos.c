@@ -0,0 +1,135 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: vencimientos.c
+#	Descripcion: Montículo indexado de las fechas de entrega de los ejemplares prestados.
+#                Los préstamos, renovaciones y devoluciones lo mantienen al día, así listar los
+#                vencidos cuesta O(k) para k resultados en vez de recorrer todos los ejemplares.
+#                Las fechas se pasan a número de día con meses de 30 días, como en extenderFecha.
+#****************************************************************/
+
+#include <stdio.h>
+#include <time.h>
+#include "vencimientos.h"
+
+// Pasa una fecha dd-mm-aaaa a número de día. Devuelve -1 si no tiene el formato
+int diaFecha(const char *fecha) {
+    int d, m, a;
+    if (sscanf(fecha, "%d-%d-%d", &d, &m, &a) != 3) return -1;
+    return a * 360 + (m - 1) * 30 + (d - 1);
+}
+
+// Pasa un número de día a fecha dd-mm-aaaa (fecha debe tener espacio para 11 caracteres)
+void fechaDia(int dia, char *fecha) {
+    unsigned d = dia;
+    snprintf(fecha, 11, "%02u-%02u-%04u", d % 30 + 1, d / 30 % 12 + 1, d / 360 % 10000);
+}
+
+// Número de día de la fecha actual del sistema. El día 31 cuenta como 30
+int diaHoy(void) {
+    time_t ahora = time(NULL);
+    struct tm fecha;
+    localtime_r(&ahora, &fecha);
+    int d = fecha.tm_mday > 30 ? 30 : fecha.tm_mday;
+    return (fecha.tm_year + 1900) * 360 + fecha.tm_mon * 30 + (d - 1);
+}
+
+// Deja el montículo vacío
+void iniciarVencimientos(struct Vencimientos *v) {
+    v->num = 0;
+    for (int i = 0; i < MAX_LIBROS; i++) {
+        for (int j = 0; j < MAX_EJEMPLAR; j++) {
+            v->posicion[i][j] = -1;
+        }
+    }
+}
+
+// Pone el nodo en la posición k y actualiza el índice
+static void colocar(struct Vencimientos *v, int k, struct Vencimiento nodo) {
+    v->nodos[k] = nodo;
+    v->posicion[nodo.libro][nodo.ejemplar] = k;
+}
+
+// Sube el nodo k mientras su fecha sea menor que la de su padre
+static void subir(struct Vencimientos *v, int k) {
+    struct Vencimiento nodo = v->nodos[k];
+    while (k > 0 && v->nodos[(k - 1) / 2].dia > nodo.dia) {
+        colocar(v, k, v->nodos[(k - 1) / 2]);
+        k = (k - 1) / 2;
+    }
+    colocar(v, k, nodo);
+}
+
+// Baja el nodo k mientras algún hijo tenga fecha menor
+static void bajar(struct Vencimientos *v, int k) {
+    struct Vencimiento nodo = v->nodos[k];
+    while (2 * k + 1 < v->num) {
+        int hijo = 2 * k + 1;
+        if (hijo + 1 < v->num && v->nodos[hijo + 1].dia < v->nodos[hijo].dia) hijo++;
+        if (v->nodos[hijo].dia >= nodo.dia) break;
+        colocar(v, k, v->nodos[hijo]);
+        k = hijo;
+    }
+    colocar(v, k, nodo);
+}
+
+// Agrega el ejemplar con su fecha de entrega o, si ya estaba, le cambia la fecha (renovación)
+void programarVencimiento(struct Vencimientos *v, int libro, int ejemplar, int dia) {
+    if (libro < 0 || libro >= MAX_LIBROS || ejemplar < 0 || ejemplar >= MAX_EJEMPLAR || dia < 0) return;
+    int k = v->posicion[libro][ejemplar];
+    if (k < 0) {
+        k = v->num++;
+        struct Vencimiento nodo = {dia, libro, ejemplar, 0};
+        colocar(v, k, nodo);
+        subir(v, k);
+        return;
+    }
+    int anterior = v->nodos[k].dia;
+    v->nodos[k].dia = dia;
+    v->nodos[k].avisado = 0;
+    if (dia < anterior) {
+        subir(v, k);
+    } else {
+        bajar(v, k);
+    }
+}
+
+// Quita el ejemplar del montículo (devolución). No hace nada si no estaba prestado
+void quitarVencimiento(struct Vencimientos *v, int libro, int ejemplar) {
+    if (libro < 0 || libro >= MAX_LIBROS || ejemplar < 0 || ejemplar >= MAX_EJEMPLAR) return;
+    int k = v->posicion[libro][ejemplar];
+    if (k < 0) return;
+    v->posicion[libro][ejemplar] = -1;
+    v->num--;
+    if (k == v->num) return;
+    // El último nodo ocupa el hueco y se reacomoda hacia donde haga falta
+    colocar(v, k, v->nodos[v->num]);
+    subir(v, k);
+    bajar(v, v->posicion[v->nodos[k].libro][v->nodos[k].ejemplar]);
+}
+
+// Copia en vencidos hasta max ejemplares con fecha de entrega anterior a hoy y devuelve cuántos copió.
+// Solo se recorren los nodos vencidos y sus hijos directos (si un nodo no está vencido, nada debajo
+// de él lo está), así el costo es O(k). Se usa una pila explícita para no depender de recursión
+int listarVencidos(struct Vencimientos *v, int hoy, struct Vencimiento *vencidos, int max) {
+    int pila[MAX_VENCIMIENTOS];
+    int tope = 0, n = 0;
+    if (v->num > 0) pila[tope++] = 0;
+    while (tope > 0 && n < max) {
+        int k = pila[--tope];
+        if (v->nodos[k].dia >= hoy) continue;
+        vencidos[n++] = v->nodos[k];
+        if (2 * k + 1 < v->num) pila[tope++] = 2 * k + 1;
+        if (2 * k + 2 < v->num) pila[tope++] = 2 * k + 2;
+    }
+    return n;
+}
+
+// Marca que ya se avisó el vencimiento del ejemplar, para no repetir el recordatorio
+void marcarAvisado(struct Vencimientos *v, int libro, int ejemplar) {
+    int k = v->posicion[libro][ejemplar];
+    if (k >= 0) v->nodos[k].avisado = 1;
+}
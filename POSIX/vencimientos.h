@@ -0,0 +1,46 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: vencimientos.h
+#	Descripcion: Archivo de encabezado para vencimientos.c.
+#                Define el montículo indexado de fechas de entrega usado para encontrar los préstamos vencidos
+#****************************************************************/
+
+#ifndef VENCIMIENTOS_H
+#define VENCIMIENTOS_H
+
+#include "receptor.h"
+
+#define MAX_VENCIMIENTOS (MAX_LIBROS * MAX_EJEMPLAR)
+
+// Un ejemplar prestado con su fecha de entrega como número de día
+struct Vencimiento {
+    int dia;
+    int libro;
+    int ejemplar;
+    int avisado; // 1 si el hilo de recordatorios ya avisó que está vencido
+};
+
+// Montículo de mínimos por fecha de entrega. posicion dice dónde está cada ejemplar (-1 si no está
+// prestado), así un préstamo, renovación o devolución lo actualiza en O(log n) sin buscarlo.
+// Se protege con mutexLibros, igual que el catálogo
+struct Vencimientos {
+    struct Vencimiento nodos[MAX_VENCIMIENTOS];
+    int num;
+    int posicion[MAX_LIBROS][MAX_EJEMPLAR];
+};
+
+// Funciones de vencimientos
+int diaFecha(const char *fecha);
+void fechaDia(int dia, char *fecha);
+int diaHoy(void);
+void iniciarVencimientos(struct Vencimientos *v);
+void programarVencimiento(struct Vencimientos *v, int libro, int ejemplar, int dia);
+void quitarVencimiento(struct Vencimientos *v, int libro, int ejemplar);
+int listarVencidos(struct Vencimientos *v, int hoy, struct Vencimiento *vencidos, int max);
+void marcarAvisado(struct Vencimientos *v, int libro, int ejemplar);
+
+#endif
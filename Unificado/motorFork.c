@@ -0,0 +1,158 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: motorFork.c
+#	Descripcion: Modelo fork del receptor unificado: las operaciones las aplican procesos hijos que
+#                reciben por un pipe anónimo las de sus ISBN. El catálogo está en memoria compartida,
+#                así todos trabajan sobre el mismo y el padre guarda el estado final. Los hijos le
+#                devuelven el resultado al padre, que es el que tiene los escritores de respuestas y
+#                la ventana de duplicados.
+#****************************************************************/
+
+#include <stdio.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "motores.h"
+
+// Lo que un hijo le devuelve al padre: la operación con su resultado. Cabe en una escritura
+// atómica del pipe de resultados, así los de varios hijos no se mezclan
+struct Resultado {
+    struct Operaciones op;
+    struct Respuesta r;
+};
+
+// Un mutex compartido entre procesos por hijo; el hijo lo toma mientras cambia sus libros
+static pthread_mutex_t *candados = NULL;
+static int tuberias[MAX_HILOS];
+static pid_t hijos[MAX_HILOS];
+static int numHijos = 0;
+// Pipe por el que todos los hijos devuelven sus resultados y el hilo del padre que los responde
+static int resultados[2] = {-1, -1};
+static pthread_t hiloResultados;
+static int conResultados = 0;
+
+// Lee un registro completo de tam bytes del pipe. Devuelve 0 cuando se cerró del otro lado
+static int leerCompleto(int fd, void *registro, size_t tam) {
+    size_t leidos = 0;
+    while (leidos < tam) {
+        ssize_t bytes = read(fd, (char *)registro + leidos, tam - leidos);
+        if (bytes <= 0) return 0;
+        leidos += bytes;
+    }
+    return 1;
+}
+
+// Proceso hijo: aplica las operaciones que le llegan hasta que el padre cierre su pipe y le
+// devuelve cada resultado
+static void atenderHijo(int k, int fd) {
+    struct Resultado resultado;
+    while (leerCompleto(fd, &resultado.op, sizeof(resultado.op))) {
+        pthread_mutex_lock(&candados[k]);
+        resultado.r = aplicar(&resultado.op);
+        pthread_mutex_unlock(&candados[k]);
+        if (write(resultados[1], &resultado, sizeof(resultado)) != (ssize_t)sizeof(resultado)) {
+            printf("Error al devolver el resultado de ISBN %d\n", resultado.op.isbn);
+        }
+    }
+    fflush(stdout);
+    _exit(0);
+}
+
+// Hilo del padre: responde los resultados de los hijos hasta que todos terminen
+static void *responderResultados(void *args) {
+    (void)args;
+    struct Resultado resultado;
+    while (leerCompleto(resultados[0], &resultado, sizeof(resultado))) {
+        responder(&resultado.op, &resultado.r);
+    }
+    return NULL;
+}
+
+// Crea un hijo con su pipe por cada hilo pedido con -n y el hilo que responde sus resultados.
+// Debe llamarse antes de crear hilos
+static int iniciar(int hilos) {
+    candados = mmap(NULL, sizeof(pthread_mutex_t) * MAX_HILOS, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (candados == MAP_FAILED) return 0;
+    if (pipe(resultados) == -1) return 0;
+    pthread_mutexattr_t atributos;
+    pthread_mutexattr_init(&atributos);
+    pthread_mutexattr_setpshared(&atributos, PTHREAD_PROCESS_SHARED);
+    //Lo que esté en el buffer de stdout no se debe imprimir también en cada hijo
+    fflush(stdout);
+    for (int k = 0; k < hilos; k++) {
+        pthread_mutex_init(&candados[k], &atributos);
+        int tuberia[2];
+        if (pipe(tuberia) == -1) return 0;
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(tuberia[0]);
+            close(tuberia[1]);
+            return 0;
+        } else if (pid == 0) {
+            //El hijo solo lee su propio pipe y escribe en el de resultados
+            for (int j = 0; j < numHijos; j++) {
+                close(tuberias[j]);
+            }
+            close(tuberia[1]);
+            close(resultados[0]);
+            atenderHijo(k, tuberia[0]);
+        }
+        close(tuberia[0]);
+        tuberias[k] = tuberia[1];
+        hijos[k] = pid;
+        numHijos++;
+    }
+    pthread_mutexattr_destroy(&atributos);
+    //Solo los hijos escriben resultados: el pipe se cierra del todo cuando terminan todos
+    close(resultados[1]);
+    resultados[1] = -1;
+    if (pthread_create(&hiloResultados, NULL, responderResultados, NULL) != 0) return 0;
+    conResultados = 1;
+    return 1;
+}
+
+// Manda la operación al hijo de su ISBN. Cabe en una sola escritura atómica del pipe
+static void despachar(struct Operaciones *op) {
+    if (write(tuberias[fragmentoDe(op->isbn, numHijos)], op, sizeof(*op)) != (ssize_t)sizeof(*op)) {
+        printf("Error al pasar la operación de ISBN %d a su proceso\n", op->isbn);
+    }
+}
+
+// Se toman los mutex de todos los hijos, siempre en el mismo orden, para imprimir un estado fijo
+static void reporte(void) {
+    for (int k = 0; k < numHijos; k++) {
+        pthread_mutex_lock(&candados[k]);
+    }
+    imprimirLibros(stdout, libros, numLibros);
+    for (int k = numHijos - 1; k >= 0; k--) {
+        pthread_mutex_unlock(&candados[k]);
+    }
+}
+
+// Al cerrar los pipes cada hijo termina lo que tenga pendiente y sale
+static void terminar(void) {
+    for (int k = 0; k < numHijos; k++) {
+        if (tuberias[k] >= 0) {
+            close(tuberias[k]);
+            tuberias[k] = -1;
+        }
+    }
+    for (int k = 0; k < numHijos; k++) {
+        if (hijos[k] > 0) {
+            waitpid(hijos[k], NULL, 0);
+            hijos[k] = 0;
+        }
+    }
+    //Con los hijos terminados el hilo responde lo último que devolvieron y sale
+    if (conResultados) {
+        pthread_join(hiloResultados, NULL);
+        conResultados = 0;
+    }
+}
+
+const struct Motor motorFork = {"fork", iniciar, despachar, NULL, reporte, terminar};
@@ -0,0 +1,113 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: motorFragmentado.c
+#	Descripcion: Modelo sharded del receptor unificado: el catálogo se reparte por ISBN entre los
+#                hilos y cada uno tiene su propia cola y su propio mutex. Dos operaciones de libros
+#                de fragmentos distintos nunca compiten por el mismo bloqueo, y las de un mismo
+#                libro se aplican en orden porque siempre van a la misma cola.
+#****************************************************************/
+
+#include <pthread.h>
+#include "motores.h"
+
+// Un fragmento: la cola de las operaciones de sus ISBN y el hilo que las aplica
+struct Fragmento {
+    struct Operaciones cola[BUFFER_TAM];
+    int inicio;
+    int cont;
+    pthread_mutex_t mutex;
+    pthread_cond_t noVacio;
+    pthread_cond_t noLleno;
+    // Se toma mientras el hilo cambia los libros del fragmento, para que el reporte no vea un cambio a medias
+    pthread_mutex_t mutexLibros;
+    pthread_t hilo;
+};
+
+static struct Fragmento fragmentos[MAX_HILOS];
+static int numFragmentos = 0;
+static int fin = 0;
+
+// Aplica las operaciones de la cola del fragmento hasta que se termine y quede vacía
+static void *atenderFragmento(void *args) {
+    struct Fragmento *f = (struct Fragmento *)args;
+    while (1) {
+        pthread_mutex_lock(&f->mutex);
+        while (f->cont == 0 && !fin) {
+            pthread_cond_wait(&f->noVacio, &f->mutex);
+        }
+        if (f->cont == 0) {
+            pthread_mutex_unlock(&f->mutex);
+            break;
+        }
+        struct Operaciones op = f->cola[f->inicio];
+        f->inicio = (f->inicio + 1) % BUFFER_TAM;
+        f->cont--;
+        pthread_cond_signal(&f->noLleno);
+        pthread_mutex_unlock(&f->mutex);
+
+        pthread_mutex_lock(&f->mutexLibros);
+        struct Respuesta r = aplicar(&op);
+        pthread_mutex_unlock(&f->mutexLibros);
+        responder(&op, &r);
+    }
+    return NULL;
+}
+
+// Crea un fragmento con su hilo por cada hilo pedido con -n
+static int iniciar(int hilos) {
+    for (int k = 0; k < hilos; k++) {
+        struct Fragmento *f = &fragmentos[k];
+        f->inicio = 0;
+        f->cont = 0;
+        pthread_mutex_init(&f->mutex, NULL);
+        pthread_cond_init(&f->noVacio, NULL);
+        pthread_cond_init(&f->noLleno, NULL);
+        pthread_mutex_init(&f->mutexLibros, NULL);
+        if (pthread_create(&f->hilo, NULL, atenderFragmento, f) != 0) return 0;
+        numFragmentos++;
+    }
+    return 1;
+}
+
+// Deja la operación en la cola del fragmento de su ISBN, esperando si está llena
+static void despachar(struct Operaciones *op) {
+    struct Fragmento *f = &fragmentos[fragmentoDe(op->isbn, numFragmentos)];
+    pthread_mutex_lock(&f->mutex);
+    while (f->cont == BUFFER_TAM) {
+        pthread_cond_wait(&f->noLleno, &f->mutex);
+    }
+    f->cola[(f->inicio + f->cont) % BUFFER_TAM] = *op;
+    f->cont++;
+    pthread_cond_signal(&f->noVacio);
+    pthread_mutex_unlock(&f->mutex);
+}
+
+// Se toman los mutex de todos los fragmentos, siempre en el mismo orden, para imprimir un estado fijo
+static void reporte(void) {
+    for (int k = 0; k < numFragmentos; k++) {
+        pthread_mutex_lock(&fragmentos[k].mutexLibros);
+    }
+    imprimirLibros(stdout, libros, numLibros);
+    for (int k = numFragmentos - 1; k >= 0; k--) {
+        pthread_mutex_unlock(&fragmentos[k].mutexLibros);
+    }
+}
+
+// Cada hilo vacía su cola antes de salir
+static void terminar(void) {
+    for (int k = 0; k < numFragmentos; k++) {
+        pthread_mutex_lock(&fragmentos[k].mutex);
+        fin = 1;
+        pthread_cond_broadcast(&fragmentos[k].noVacio);
+        pthread_mutex_unlock(&fragmentos[k].mutex);
+    }
+    for (int k = 0; k < numFragmentos; k++) {
+        pthread_join(fragmentos[k].hilo, NULL);
+    }
+}
+
+const struct Motor motorFragmentado = {"sharded", iniciar, despachar, NULL, reporte, terminar};
@@ -0,0 +1,67 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: motorOmp.c
+#	Descripcion: Modelo omp del receptor unificado: el hilo principal junta las operaciones en un
+#                lote y, cuando se llena o el pipe se queda sin tramas, lo aplica en una región
+#                paralela de OpenMP. Cada hilo del equipo toma las operaciones de sus ISBN en el
+#                orden del lote, así no hace falta ningún bloqueo por libro.
+#****************************************************************/
+
+#include <omp.h>
+#include "motores.h"
+
+static struct Operaciones lote[MAX_LOTE_OMP];
+static struct Respuesta respuestas[MAX_LOTE_OMP];
+static int numLote = 0;
+static int numHilos = 1;
+// Lo tiene el hilo principal mientras el equipo cambia el catálogo, para que el reporte no vea un cambio a medias
+static omp_lock_t candadoLibros;
+
+// Aplica el lote pendiente y responde cada operación
+static void aplicarLote(void) {
+    if (numLote == 0) return;
+    omp_set_lock(&candadoLibros);
+    #pragma omp parallel num_threads(numHilos)
+    {
+        int t = omp_get_thread_num();
+        int n = omp_get_num_threads();
+        for (int k = 0; k < numLote; k++) {
+            if (fragmentoDe(lote[k].isbn, n) == t) {
+                respuestas[k] = aplicar(&lote[k]);
+            }
+        }
+    }
+    omp_unset_lock(&candadoLibros);
+    //Las respuestas se escriben fuera del candado, repartidas entre el equipo
+    #pragma omp parallel for num_threads(numHilos) schedule(dynamic)
+    for (int k = 0; k < numLote; k++) {
+        responder(&lote[k], &respuestas[k]);
+    }
+    numLote = 0;
+}
+
+static int iniciar(int hilos) {
+    numHilos = hilos;
+    omp_init_lock(&candadoLibros);
+    return 1;
+}
+
+// Junta la operación en el lote y lo aplica si se llenó
+static void despachar(struct Operaciones *op) {
+    lote[numLote++] = *op;
+    if (numLote == MAX_LOTE_OMP) {
+        aplicarLote();
+    }
+}
+
+static void reporte(void) {
+    omp_set_lock(&candadoLibros);
+    imprimirLibros(stdout, libros, numLibros);
+    omp_unset_lock(&candadoLibros);
+}
+
+const struct Motor motorOmp = {"omp", iniciar, despachar, aplicarLote, reporte, aplicarLote};
@@ -0,0 +1,109 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: motorPosix.c
+#	Descripcion: Modelo posix del receptor unificado, con los hilos POSIX del receptor original:
+#                hilos auxiliar1 que sacan las operaciones de un buffer y un solo mutex para todo el
+#                catálogo. Cada auxiliar1 tiene su buffer con las operaciones de sus ISBN, así las
+#                de un mismo libro se aplican en el orden en que llegaron.
+#****************************************************************/
+
+#include <pthread.h>
+#include "motores.h"
+
+// Buffer circular de un auxiliar1 con su mutex y variables de condición
+struct Buffer {
+    struct Operaciones ops[BUFFER_TAM];
+    int inicio;
+    int cont;
+    pthread_mutex_t mutex;
+    pthread_cond_t condNoVacio;
+    pthread_cond_t condNoLleno;
+    pthread_t hilo;
+};
+
+static struct Buffer buffers[MAX_HILOS];
+static int numAuxiliares = 0;
+static int fin = 0;
+// Protege el catálogo completo, lo comparten todos los auxiliar1
+static pthread_mutex_t mutexLibros = PTHREAD_MUTEX_INITIALIZER;
+
+// Atiende las operaciones de su buffer hasta que se termine y quede vacío. Aplica cada una con
+// el catálogo bloqueado y responde después de liberarlo
+static void *auxiliar1(void *args) {
+    struct Buffer *b = (struct Buffer *)args;
+    while (1) {
+        pthread_mutex_lock(&b->mutex);
+        while (b->cont == 0 && !fin) {
+            pthread_cond_wait(&b->condNoVacio, &b->mutex);
+        }
+        if (b->cont == 0) {
+            pthread_mutex_unlock(&b->mutex);
+            break;
+        }
+        struct Operaciones op = b->ops[b->inicio];
+        b->inicio = (b->inicio + 1) % BUFFER_TAM;
+        b->cont--;
+        pthread_cond_signal(&b->condNoLleno);
+        pthread_mutex_unlock(&b->mutex);
+
+        pthread_mutex_lock(&mutexLibros);
+        struct Respuesta r = aplicar(&op);
+        pthread_mutex_unlock(&mutexLibros);
+        responder(&op, &r);
+    }
+    return NULL;
+}
+
+// Crea los hilos auxiliar1 (uno por cada hilo pedido con -n), cada uno con su buffer
+static int iniciar(int hilos) {
+    for (int k = 0; k < hilos; k++) {
+        struct Buffer *b = &buffers[k];
+        b->inicio = 0;
+        b->cont = 0;
+        pthread_mutex_init(&b->mutex, NULL);
+        pthread_cond_init(&b->condNoVacio, NULL);
+        pthread_cond_init(&b->condNoLleno, NULL);
+        if (pthread_create(&b->hilo, NULL, auxiliar1, b) != 0) return 0;
+        numAuxiliares++;
+    }
+    return 1;
+}
+
+// P, D y R van al buffer del auxiliar1 de su ISBN, esperando si está lleno
+static void despachar(struct Operaciones *op) {
+    struct Buffer *b = &buffers[fragmentoDe(op->isbn, numAuxiliares)];
+    pthread_mutex_lock(&b->mutex);
+    while (b->cont == BUFFER_TAM) {
+        pthread_cond_wait(&b->condNoLleno, &b->mutex);
+    }
+    b->ops[(b->inicio + b->cont) % BUFFER_TAM] = *op;
+    b->cont++;
+    pthread_cond_signal(&b->condNoVacio);
+    pthread_mutex_unlock(&b->mutex);
+}
+
+static void reporte(void) {
+    pthread_mutex_lock(&mutexLibros);
+    imprimirLibros(stdout, libros, numLibros);
+    pthread_mutex_unlock(&mutexLibros);
+}
+
+// Los auxiliares vacían sus buffers antes de salir
+static void terminar(void) {
+    for (int k = 0; k < numAuxiliares; k++) {
+        pthread_mutex_lock(&buffers[k].mutex);
+        fin = 1;
+        pthread_cond_broadcast(&buffers[k].condNoVacio);
+        pthread_mutex_unlock(&buffers[k].mutex);
+    }
+    for (int k = 0; k < numAuxiliares; k++) {
+        pthread_join(buffers[k].hilo, NULL);
+    }
+    numAuxiliares = 0;
+}
+
+const struct Motor motorPosix = {"posix", iniciar, despachar, NULL, reporte, terminar};
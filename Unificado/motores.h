@@ -0,0 +1,25 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: motores.h
+#	Descripcion: Archivo de encabezado de los modelos de concurrencia del receptor unificado.
+#                Cada uno está en su propio archivo y se elige con -m
+#****************************************************************/
+
+#ifndef MOTORES_H
+#define MOTORES_H
+
+#include "receptor.h"
+
+// Operaciones que el modelo omp junta antes de repartirlas entre sus hilos
+#define MAX_LOTE_OMP 64
+
+extern const struct Motor motorPosix; // Hilos POSIX con buffer compartido (motorPosix.c)
+extern const struct Motor motorOmp; // Lotes repartidos con OpenMP (motorOmp.c)
+extern const struct Motor motorFork; // Procesos hijos sobre el catálogo compartido (motorFork.c)
+extern const struct Motor motorFragmentado; // Un hilo y una cola por fragmento de ISBN (motorFragmentado.c)
+
+#endif
@@ -0,0 +1,324 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: receptor.c
+#	Descripcion: Receptor unificado, banco de modelos de concurrencia para P, D y R. Lee las
+#                tramas y responde con el protocolo del receptor POSIX (protocolo.c, respuestas.c
+#                y duplicados.c), igual para todos los modelos, y deja que el modelo elegido con -m
+#                (posix, omp, fork o sharded) decida cómo se aplican las operaciones sobre el
+#                catálogo de libbiblioteca. No reemplaza al receptor POSIX: el resto de operaciones
+#                se responden como no soportadas.
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "receptor.h"
+#include "motores.h"
+#include "respuestas.h"
+#include "duplicados.h"
+
+struct Libros *libros = NULL;
+int numLibros = 0;
+int verbose = 0;
+// Se marca al salir; lo revisan los módulos del receptor POSIX que se enlazan aquí
+int terminar = 0;
+// Pipe principal, abierto también para escribir: la consola deja ahí la Q al pedir 's'
+static int fdReceptor = -1;
+
+// Modelos que se pueden elegir con -m; el primero es el de defecto
+static const struct Motor *motores[] = {&motorPosix, &motorOmp, &motorFork, &motorFragmentado};
+#define NUM_MOTORES ((int)(sizeof(motores) / sizeof(motores[0])))
+
+// Imprime los mensajes de la carga del catálogo: los avisos siempre y lo leído solo con -v
+static void informeCarga(int aviso, const char *mensaje) {
+    if (aviso || verbose) {
+        printf("%s\n", mensaje);
+    }
+}
+
+// Aplica la operación sobre el catálogo y copia el número y la entrega del ejemplar que cambió.
+// D y R toman el ejemplar de quien las pide, como en el receptor POSIX. Quien llama debe tener protegido el libro de la operación con la sincronización de su modelo
+struct Respuesta aplicar(struct Operaciones *op) {
+    struct Respuesta r = {aplicarOperacion(libros, numLibros, op->tipo, op->isbn, op->nombre, prestatarioDe(op)), 0, 0};
+    if (r.res.codigo == BIB_EXITO) {
+        struct Ejemplar *e = &libros[r.res.libro].ejemplares[r.res.ejemplar];
+        r.numero = e->numero;
+        r.entrega = op->tipo == 'D' ? 0 : fechaCompacta(e->fecha);
+    }
+    return r;
+}
+
+// Arma la respuesta compacta (codigos.h) de una operación aplicada, la guarda para sus reenvíos y
+// la deja en la cola de salida del solicitante. Con -v también se imprime
+void responder(struct Operaciones *op, const struct Respuesta *r) {
+    char respuesta[LARGO_COMPACTA + 1];
+    if (r->res.codigo == BIB_NO_ENCONTRADO) {
+        armarRespuesta(respuesta, RESP_ERROR_NO_ENCONTRADO, op->isbn, 0, 0, 0);
+    } else if (r->res.codigo == BIB_SIN_EJEMPLAR) {
+        armarRespuesta(respuesta, RESP_ERROR_SIN_EJEMPLAR, op->isbn, 0, 0, 0);
+    } else if (r->res.codigo == BIB_SIN_PRESTAMO) {
+        armarRespuesta(respuesta, RESP_ERROR_SIN_PRESTAMO, op->isbn, 0, 0, 0);
+    } else if (r->res.codigo == BIB_OPERACION_INVALIDA) {
+        armarRespuesta(respuesta, RESP_ERROR_NO_SOPORTADA, 0, op->tipo, 0, 0);
+    } else if (op->tipo == 'P') {
+        armarRespuesta(respuesta, RESP_PRESTAMO, op->isbn, r->numero, r->entrega, 0);
+    } else if (op->tipo == 'D') {
+        armarRespuesta(respuesta, RESP_DEVOLUCION, op->isbn, r->numero, 0, 0);
+    } else {
+        armarRespuesta(respuesta, RESP_RENOVACION, op->isbn, r->numero, r->entrega, 0);
+    }
+    if (verbose) {
+        printf("Respuesta a %d: %c, ISBN %d, código %d, ejemplar %d\n", op->pid, op->tipo, op->isbn, respuesta[1], r->numero);
+    }
+    guardarRespuestaDuplicado(op, respuesta);
+    responderSecuencia(op, respuesta, 0);
+}
+
+// Fragmento (hilo, proceso o cola) que atiende un ISBN. Todas las operaciones de un libro caen en
+// el mismo, así se aplican en el orden en que llegaron aunque haya varios trabajando a la vez
+int fragmentoDe(int isbn, int fragmentos) {
+    return (unsigned)isbn % fragmentos;
+}
+
+// El receptor unificado tiene un solo catálogo, el que se llama BIBLIOTECA_DEFECTO. Devuelve 0 si
+// b= lo nombra y -1 si nombra otro
+int buscarBiblioteca(const char *id, size_t largo) {
+    return strlen(BIBLIOTECA_DEFECTO) == largo && strncmp(BIBLIOTECA_DEFECTO, id, largo) == 0 ? 0 : -1;
+}
+
+// Valida una trama "tipo,nombre,isbn,pid" y lee sus campos opcionales r=, b= y s= como el
+// receptor POSIX (r= se lee pero no hay listas de espera). Devuelve 0 si el formato es inválido
+int leerPipe(char *trama, struct Operaciones *op) {
+    memset(op, 0, sizeof(*op));
+    if (sscanf(trama, "%c,%249[^,],%d,%d", &op->tipo, op->nombre, &op->isbn, &op->pid) != 4) {
+        printf("Formato inválido recibido: %.60s\n", trama);
+        return 0;
+    }
+    leerCamposOpcionales(trama, 4, op);
+    if (verbose) {
+        printf("Recibido: tipo = %c, nombre = %s, isbn = %d, pid = %d\n", op->tipo, op->nombre, op->isbn, op->pid);
+    }
+    return 1;
+}
+
+// Los lotes M solo los atiende el receptor POSIX: se contesta cada línea con el error, en el
+// formato de la respuesta de un lote para que el solicitante no se quede esperando
+static void rechazarLote(char *trama) {
+    int num, pid;
+    if (sscanf(trama, "M,%d,%d", &num, &pid) != 2 || num < 1 || num > MAX_LOTE) {
+        printf("Lote inválido recibido: %.60s\n", trama);
+        return;
+    }
+    char respuesta[MAX_RESPUESTA_LOTE];
+    int largo = snprintf(respuesta, sizeof(respuesta), "M,%d", num);
+    for (int k = 0; k < num; k++) {
+        respuesta[largo++] = '\n';
+        largo += armarRespuesta(respuesta + largo, RESP_ERROR_NO_SOPORTADA, 0, 'M', 0, 0);
+    }
+    enviarRespuesta(pid, respuesta);
+}
+
+// Descarta lo que quede de la línea de la consola
+static void limpiarLinea(void) {
+    int c;
+    while ((c = getchar()) != '\n' && c != EOF) {
+    }
+}
+
+// Maneja comandos interactivos del usuario (s para salir, r para generar reporte)
+void *consola(void *args) {
+    const struct Motor *motor = (const struct Motor *)args;
+    char comando[3];
+    while (1) {
+        if (scanf("%2s", comando) != 1) {
+            //Sin consola (fin de la entrada) se espera la Q de un solicitante
+            if (feof(stdin)) break;
+            limpiarLinea();
+            printf("Entrada inválida, utilice 's' para salir o 'r' para reporte\n");
+            continue;
+        }
+        limpiarLinea();
+        if (strcmp(comando, "s") == 0) {
+            //Se deja una Q en el pipe principal, así el hilo principal termina como con la de un solicitante
+            char salida[32];
+            int largo = snprintf(salida, sizeof(salida), "Q,Salir,0,%d", (int)getpid());
+            if (write(fdReceptor, salida, largo + 1) == -1) {
+                printf("Error al escribir la salida en el pipe principal\n");
+            }
+            break;
+        } else if (strcmp(comando, "r") == 0) {
+            printf("Reporte:\n");
+            motor->reporte();
+        } else {
+            printf("Utilice solo 's' o 'r' si quiere acabar la ejecución o ver un reporte\n");
+        }
+    }
+    return NULL;
+}
+
+// Proceso principal
+int main(int argc, char *argv[]) {
+    if (argc < 5 || argc > 12) {
+        printf("\n \t\tUse: $./receptor –p pipeReceptor –f filedatos [-m posix|omp|fork|sharded] [-n hilos] [-v] [–s filesalida]\n");
+        exit(1);
+    }
+
+    char *pipeRec = NULL;
+    char *nomArchivo = NULL;
+    char *fileSalida = NULL;
+    char *modelo = NULL;
+    int hilos = HILOS_DEFECTO;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            pipeRec = argv[++i];
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            nomArchivo = argv[++i];
+        } else if (strcmp(argv[i], "-v") == 0) {
+            verbose = 1;
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            fileSalida = argv[++i];
+        } else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            modelo = argv[++i];
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            hilos = atoi(argv[++i]);
+        }
+    }
+
+    if (!pipeRec || !nomArchivo) {
+        printf("\n \t\tUse: $./receptor –p pipeReceptor –f filedatos [-m posix|omp|fork|sharded] [-n hilos] [-v] [–s filesalida]\n");
+        exit(1);
+    }
+    const struct Motor *motor = modelo ? NULL : motores[0];
+    for (int k = 0; modelo && k < NUM_MOTORES; k++) {
+        if (strcmp(modelo, motores[k]->nombre) == 0) motor = motores[k];
+    }
+    if (!motor) {
+        printf("Error: -m debe ser posix, omp, fork o sharded\n");
+        exit(1);
+    }
+    if (hilos < 1 || hilos > MAX_HILOS) {
+        printf("Error: -n debe estar entre 1 y %d\n", MAX_HILOS);
+        exit(1);
+    }
+
+    //El catálogo va en memoria compartida para que lo vean los hijos del modelo fork
+    libros = mmap(NULL, sizeof(struct Libros) * MAX_LIBROS, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (libros == MAP_FAILED) {
+        printf("Error al reservar memoria para el catálogo\n");
+        exit(1);
+    }
+    numLibros = cargarLibros(nomArchivo, libros, MAX_LIBROS, informeCarga);
+    if (numLibros < 0) {
+        printf("Error al abrir el archivo %s\n", nomArchivo);
+        exit(1);
+    }
+    if (numLibros == 0) {
+        printf("Error cargando la base de datos\n");
+        exit(1);
+    }
+
+    //Si un solicitante o un hijo del modelo fork ya cerró su pipe, write devuelve error en vez de
+    //matar al receptor
+    signal(SIGPIPE, SIG_IGN);
+    //Los procesos del modelo fork se crean antes que cualquier hilo
+    if (!motor->iniciar(hilos)) {
+        printf("Error al iniciar el modelo %s\n", motor->nombre);
+        exit(1);
+    }
+    if (!iniciarEscritores(ESCRITORES_DEFECTO, ESPERA_AGRUPAR_DEFECTO_US, PIPE_BUF)) {
+        printf("Error al crear los escritores de respuestas\n");
+        motor->terminar();
+        exit(1);
+    }
+
+    if (mkfifo(pipeRec, 0666) == -1 && errno != EEXIST) {
+        printf("Error al crear el pipe %s\n", pipeRec);
+        motor->terminar();
+        exit(1);
+    }
+    int fd = open(pipeRec, O_RDWR);
+    fdReceptor = fd;
+    if (fd < 0) {
+        printf("Error al abrir el pipe %s\n", pipeRec);
+        motor->terminar();
+        unlink(pipeRec);
+        exit(1);
+    }
+    printf("Receptor con el modelo %s (%d hilos), %d libros\n", motor->nombre, hilos, numLibros);
+    fflush(stdout);
+
+    pthread_t hiloConsola;
+    pthread_create(&hiloConsola, NULL, consola, (void *)motor);
+
+    //Hilo principal: lee las tramas y le pasa las operaciones al modelo. Cuando el pipe se queda
+    //sin tramas el modelo que agrupa operaciones aplica lo que tenga
+    char trama[MAX_TRAMA];
+    struct Operaciones op;
+    while (siguienteTrama(fd, trama, sizeof(trama), motor->vaciar) >= 0) {
+        if (trama[0] == 'M') {
+            rechazarLote(trama);
+            continue;
+        }
+        if (!leerPipe(trama, &op)) {
+            continue;
+        }
+        if (op.tipo == 'Q') {
+            break;
+        }
+        char respuesta[LARGO_COMPACTA + 1];
+        if (op.biblioteca < 0) {
+            armarRespuesta(respuesta, RESP_ERROR_BIBLIOTECA, 0, 0, 0, 0);
+            responderSecuencia(&op, respuesta, 0);
+            continue;
+        }
+        //B, C y L son solo del receptor POSIX
+        if (op.tipo != 'P' && op.tipo != 'D' && op.tipo != 'R') {
+            struct Respuesta r = {{BIB_OPERACION_INVALIDA, -1, -1}, 0, 0};
+            responder(&op, &r);
+            continue;
+        }
+        //Un reenvío que ya se respondió se contesta desde la ventana y uno en curso se ignora
+        int estado = revisarDuplicado(&op, respuesta);
+        //Sin lugar en la ventana se pide reintentar en vez de aplicarla sin registro
+        if (estado == DUP_LLENA) {
+            armarRespuesta(respuesta, RESP_OCUPADO, 0, REINTENTO_VENTANA_MS, 0, 0);
+            responderSecuencia(&op, respuesta, 0);
+            continue;
+        }
+        if (estado != DUP_NUEVA) {
+            if (verbose) {
+                printf("Reenvío de cliente %d, secuencia %d %s\n", op.cliente, op.secuencia, estado == DUP_RESPONDIDA ? "respondido de la ventana" : "ignorado (en curso)");
+            }
+            if (estado == DUP_RESPONDIDA) {
+                responderSecuencia(&op, respuesta, 0);
+            }
+            continue;
+        }
+        motor->despachar(&op);
+    }
+    motor->terminar();
+    terminar = 1;
+    detenerEscritores();
+
+    //Igual que los otros receptores, se termina con la Q y con 's' por consola
+    pthread_join(hiloConsola, NULL);
+    close(fd);
+    if (fileSalida && !guardarLibros(fileSalida, libros, numLibros)) {
+        printf("Error al crear el archivo de salida\n");
+    }
+    unlink(pipeRec);
+    munmap(libros, sizeof(struct Libros) * MAX_LIBROS);
+    return 0;
+}
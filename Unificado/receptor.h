@@ -0,0 +1,63 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: receptor.h
+#	Descripcion: Archivo de encabezado para receptor.c del receptor unificado.
+#                Define el resultado que se responde y la interfaz común de los modelos de
+#                concurrencia que se eligen con -m. La operación es la del protocolo POSIX
+#****************************************************************/
+
+#ifndef RECEPTOR_H
+#define RECEPTOR_H
+
+#include <limits.h>
+#include "libbiblioteca.h"
+#include "protocolo.h"
+
+#define BUFFER_TAM 10
+#define MAX_HILOS 16
+#define HILOS_DEFECTO 4
+#define MAX_TRAMA (2 * PIPE_BUF)
+// Espera que se pide al solicitante cuando la ventana de duplicados no tiene lugar para su operación
+#define REINTENTO_VENTANA_MS 10
+
+// Lo que necesita la respuesta de una operación, copiado mientras el catálogo está protegido
+struct Respuesta {
+    struct ResultadoBib res;
+    int numero;
+    int entrega; // Fecha de entrega como aaaammdd (0 en las devoluciones y errores)
+};
+
+// Modelo de concurrencia. El hilo principal lee y valida las tramas igual en todos y le pasa cada
+// P, D o R a despachar; el modelo decide quién la aplica, con qué sincronización y en qué orden.
+// Todos mantienen el orden de las operaciones de un mismo libro
+struct Motor {
+    const char *nombre;
+    // Arranca los hilos o procesos del modelo sobre el catálogo global. Devuelve 0 si falló
+    int (*iniciar)(int hilos);
+    void (*despachar)(struct Operaciones *op);
+    // Se llama cuando el pipe se queda sin tramas; el modelo que agrupa operaciones las aplica (o NULL)
+    void (*vaciar)(void);
+    // Imprime el estado del catálogo sin que cambie mientras tanto
+    void (*reporte)(void);
+    // Aplica lo que quede pendiente y espera a sus hilos o procesos
+    void (*terminar)(void);
+};
+
+// Catálogo compartido por todos los modelos. Vive en memoria compartida para que los procesos
+// del modelo fork trabajen sobre el mismo
+extern struct Libros *libros;
+extern int numLibros;
+extern int verbose;
+
+// Funciones del receptor (la lectura de tramas y el envío de respuestas son los de protocolo.c y respuestas.c)
+struct Respuesta aplicar(struct Operaciones *op);
+void responder(struct Operaciones *op, const struct Respuesta *r);
+int fragmentoDe(int isbn, int fragmentos);
+int leerPipe(char *trama, struct Operaciones *op);
+void *consola(void *args);
+
+#endif
@@ -0,0 +1,235 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: libbiblioteca.c
+#	Descripcion: Núcleo del catálogo que comparten el receptor POSIX y el unificado: carga de la
+#                base de datos, búsqueda de un libro, préstamo, devolución, renovación y escritura
+#                del estado. No sabe nada de pipes, hilos ni respuestas: cada función deja lo que
+#                hizo en su valor de retorno y quien la llama responde y sincroniza a su manera.
+#****************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include "libbiblioteca.h"
+
+// Arma el mensaje y se lo pasa a informe, si hay
+static void informar(InformeCarga informe, int aviso, const char *formato, ...) {
+    if (!informe) return;
+    char mensaje[320];
+    va_list args;
+    va_start(args, formato);
+    vsnprintf(mensaje, sizeof(mensaje), formato, args);
+    va_end(args);
+    informe(aviso, mensaje);
+}
+
+// Lee la base de datos de libros desde un archivo de texto y la carga en libros (hasta max).
+// Las líneas inválidas se saltan y se informan. Devuelve cuántos libros leyó o -1 si el archivo
+// no se pudo abrir
+int cargarLibros(const char *archivo, struct Libros *libros, int max, InformeCarga informe) {
+    FILE *entrada = fopen(archivo, "r");
+    if (!entrada) return -1;
+
+    //Char que contendrá la linea leída
+    char linea[256];
+    //Contador de libros leídos
+    int cont = 0;
+    // While que va hasta que no lea mas líneas en el archivo o sobrepase el máximo de libros
+    while (cont < max && fgets(linea, sizeof(linea), entrada)) {
+        //Ignorar líneas vacias
+        if (linea[0] == '\n' || linea[0] == '\0') continue;
+        // Elimina el salto de línea
+        linea[strcspn(linea, "\n")] = 0;
+        // Salta a la siguiente iteración si es inválido
+        if (sscanf(linea, "%249[^,],%d,%d", libros[cont].nombre, &libros[cont].isbn, &libros[cont].numEj) != 3) continue;
+        if (libros[cont].numEj <= 0 || libros[cont].numEj > MAX_EJEMPLAR) {
+            informar(informe, 1, "Número de ejemplares inválido para ISBN %d: %d", libros[cont].isbn, libros[cont].numEj);
+            continue;
+        }
+        informar(informe, 0, "Libro leído: %s, ISBN: %d, NumEj: %d", libros[cont].nombre, libros[cont].isbn, libros[cont].numEj);
+        //Leer ejemplares de libros
+        for (int i = 0; i < libros[cont].numEj && fgets(linea, sizeof(linea), entrada); i++) {
+            linea[strcspn(linea, "\n")] = 0;
+            struct Ejemplar *e = &libros[cont].ejemplares[i];
+            e->prestatario = 0;
+            char fecha[11];
+            //Acepta "1, D, 1-10-2021" y también "1,D,01-10-2021", el formato de escribirLibros
+            if (sscanf(linea, "%d , %c , %10[^,]", &e->numero, &e->status, fecha) != 3) {
+                informar(informe, 1, "Error con la línea de ejemplar: %s", linea);
+                continue;
+            }
+            int dia, mes, anio;
+            if (sscanf(fecha, "%d-%d-%d", &dia, &mes, &anio) == 3) {
+                snprintf(e->fecha, sizeof(e->fecha), "%02d-%02d-%04d", dia, mes, anio);
+                informar(informe, 0, "Ejemplar leído: Num: %d, Status: %c, Fecha: %s", e->numero, e->status, e->fecha);
+            } else {
+                //Fecha por defecto en caso de formato inválido
+                informar(informe, 1, "Error al parsear la fecha: %s", fecha);
+                snprintf(e->fecha, sizeof(e->fecha), "01-01-2000");
+            }
+        }
+        cont++;
+    }
+    fclose(entrada);
+    return cont;
+}
+
+// Escribe los libros y ejemplares con el mismo formato de la base de datos. Devuelve 0 si falló
+int escribirLibros(FILE *salida, const struct Libros *libros, int numLibros) {
+    for (int i = 0; i < numLibros; i++) {
+        fprintf(salida, "%s,%d,%d\n", libros[i].nombre, libros[i].isbn, libros[i].numEj);
+        for (int j = 0; j < libros[i].numEj; j++) {
+            fprintf(salida, "%d,%c,%s\n", libros[i].ejemplares[j].numero, libros[i].ejemplares[j].status, libros[i].ejemplares[j].fecha);
+        }
+    }
+    return !ferror(salida);
+}
+
+// Guarda los libros en un archivo con escribirLibros. Devuelve 0 si no se pudo escribir
+int guardarLibros(const char *archivo, const struct Libros *libros, int numLibros) {
+    FILE *salida = fopen(archivo, "w");
+    if (!salida) return 0;
+    int exito = escribirLibros(salida, libros, numLibros);
+    return fclose(salida) == 0 && exito;
+}
+
+// Imprime una línea por ejemplar con el formato del reporte de consola
+void imprimirLibros(FILE *salida, const struct Libros *libros, int numLibros) {
+    for (int i = 0; i < numLibros; i++) {
+        for (int j = 0; j < libros[i].numEj; j++) {
+            fprintf(salida, "%c, %s, %d, %d, %s\n", libros[i].ejemplares[j].status, libros[i].nombre, libros[i].isbn, libros[i].ejemplares[j].numero, libros[i].ejemplares[j].fecha);
+        }
+    }
+}
+
+// Devuelve la posición del libro con ese ISBN y nombre, o -1 si no está
+int buscarLibro(const struct Libros *libros, int numLibros, int isbn, const char *nombre) {
+    for (int i = 0; i < numLibros; i++) {
+        if (libros[i].isbn == isbn && strcmp(libros[i].nombre, nombre) == 0) return i;
+    }
+    return -1;
+}
+
+// Presta el primer ejemplar disponible del libro al prestatario y le corre la fecha de entrega.
+// Devuelve su posición o -1 si no hay ninguno disponible
+int prestarEjemplar(struct Libros *libro, int prestatario) {
+    for (int j = 0; j < libro->numEj; j++) {
+        if (libro->ejemplares[j].status == 'D') {
+            libro->ejemplares[j].status = 'P';
+            libro->ejemplares[j].prestatario = prestatario;
+            extenderFecha(libro->ejemplares[j].fecha);
+            return j;
+        }
+    }
+    return -1;
+}
+
+// Devuelve la posición del ejemplar que tiene el prestatario o, si no tiene ninguno, la del
+// primero prestado sin dueño conocido. -1 si no hay
+int ejemplarDe(const struct Libros *libro, int prestatario) {
+    int sinDueno = -1;
+    for (int j = 0; j < libro->numEj; j++) {
+        if (libro->ejemplares[j].status != 'P') continue;
+        if (libro->ejemplares[j].prestatario == prestatario) return j;
+        if (sinDueno < 0 && libro->ejemplares[j].prestatario == 0) sinDueno = j;
+    }
+    return sinDueno;
+}
+
+// Marca como disponible el ejemplar j y le quita el dueño
+void devolverEjemplar(struct Libros *libro, int j) {
+    libro->ejemplares[j].status = 'D';
+    libro->ejemplares[j].prestatario = 0;
+}
+
+// Corre la fecha de entrega del ejemplar j
+void renovarEjemplar(struct Libros *libro, int j) {
+    extenderFecha(libro->ejemplares[j].fecha);
+}
+
+// Aplica un préstamo (P), devolución (D) o renovación (R) sobre el libro con ese ISBN y nombre.
+// D y R usan el ejemplar del prestatario (ejemplarDe). No toma ningún bloqueo: quien llama debe tener el
+// catálogo para sí mientras dura
+struct ResultadoBib aplicarOperacion(struct Libros *libros, int numLibros, char tipo, int isbn, const char *nombre, int prestatario) {
+    struct ResultadoBib res = {BIB_OPERACION_INVALIDA, -1, -1};
+    if (tipo != 'P' && tipo != 'D' && tipo != 'R') return res;
+    res.libro = buscarLibro(libros, numLibros, isbn, nombre);
+    if (res.libro < 0) {
+        res.codigo = BIB_NO_ENCONTRADO;
+        return res;
+    }
+    struct Libros *libro = &libros[res.libro];
+    if (tipo == 'P') {
+        res.ejemplar = prestarEjemplar(libro, prestatario);
+        res.codigo = res.ejemplar < 0 ? BIB_SIN_EJEMPLAR : BIB_EXITO;
+        return res;
+    }
+    res.ejemplar = ejemplarDe(libro, prestatario);
+    if (res.ejemplar < 0) {
+        res.codigo = BIB_SIN_PRESTAMO;
+        return res;
+    }
+    if (tipo == 'D') {
+        devolverEjemplar(libro, res.ejemplar);
+    } else {
+        renovarEjemplar(libro, res.ejemplar);
+    }
+    res.codigo = BIB_EXITO;
+    return res;
+}
+
+// Escribe un día o mes (1 a 99) con dos dígitos y su '\0'. Se arma a mano porque con %02d el
+// compilador no sabe que el valor ya se acotó y avisa que podría no caber en los tres bytes
+static void dosDigitos(char *destino, int valor) {
+    destino[0] = (char)('0' + valor / 10);
+    destino[1] = (char)('0' + valor % 10);
+    destino[2] = '\0';
+}
+
+// Suma 7 días a una fecha dd-mm-aaaa, con meses de 30 días como en el resto del sistema
+void extenderFecha(char *fecha) {
+    // Se guarda las fechas en variables distintas para asegurar correctamente el cambio de fecha
+    char dia[3], mes[3], anio[5];
+    sscanf(fecha, "%2s-%2s-%4s", dia, mes, anio);
+    int d = atoi(dia);
+    //se añaden 7 días
+    d += 7;
+    //Si días resulta mayor a 30 se resta 30 a los días
+    if (d > 30) {
+        d -= 30;
+        //aumenta el mes, si es mayor a 12 se vuelve el primer mes del año
+        int m = atoi(mes);
+        m++;
+        if (m < 1 || m > 12) {
+            m = 1;
+        }
+        dosDigitos(mes, m);
+    }
+    if (d < 1 || d > 30) d = 1; // Corrige en caso de aun haber un día inválido
+    // Se cmambia el día de entero a char
+    dosDigitos(dia, d);
+    mes[2] = '\0';
+    anio[4] = '\0';
+    snprintf(fecha, 11, "%2s-%2s-%4s", dia, mes, anio);
+}
+
+// Pasa una fecha dd-mm-aaaa (el día y el mes pueden venir con un dígito, como en la base de datos)
+// a aaaammdd para compararla como entero o mandarla en una respuesta compacta, sin sscanf.
+// Devuelve 0 si no tiene ese formato
+int fechaCompacta(const char *fecha) {
+    int partes[3] = {0, 0, 0};
+    for (int k = 0; k < 3; k++) {
+        const char *inicio = fecha;
+        while (*fecha >= '0' && *fecha <= '9') {
+            partes[k] = partes[k] * 10 + (*fecha++ - '0');
+        }
+        if (fecha == inicio || fecha - inicio > (k < 2 ? 2 : 4)) return 0;
+        if (k < 2 && *fecha++ != '-') return 0;
+    }
+    return partes[2] * 10000 + partes[1] * 100 + partes[0];
+}
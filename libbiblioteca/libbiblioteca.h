@@ -0,0 +1,73 @@
+/**************************************************************
+#         		Pontificia Universidad Javeriana
+#     Autor: Grupo Delta (SAMUEL GANTIVA, CARLOS PINZON, SEBASTIAN ALVAREZ, JORGE OLAYA, DANIEL HOYOS)
+#     Fecha: 18 de Octubre de 2026
+#     Materia: Sistemas Operativos
+#     Tema: Proyecto - Sistema para el prestamo de libros
+#     Fichero: libbiblioteca.h
+#	Descripcion: Archivo de encabezado para libbiblioteca.c.
+#                Define el libro y el ejemplar que comparten los dos receptores, los códigos de
+#                resultado del catálogo y los prototipos de la librería
+#****************************************************************/
+
+#ifndef LIBBIBLIOTECA_H
+#define LIBBIBLIOTECA_H
+
+#include <stdio.h>
+
+#define MAX_EJEMPLAR 10
+#define MAX_LIBROS 100
+
+// Resultado de una operación sobre el catálogo. Cada receptor lo pasa a su propia respuesta
+#define BIB_EXITO 0
+#define BIB_NO_ENCONTRADO 1 // No hay libro con ese ISBN y nombre
+#define BIB_SIN_EJEMPLAR 2 // Préstamo sin ejemplar disponible
+#define BIB_SIN_PRESTAMO 3 // Devolución o renovación sin ejemplar prestado
+#define BIB_OPERACION_INVALIDA 4 // Tipo que no es P, D ni R
+
+//Representa un ejemplar de un libro con su número, estado, fecha y quién lo tiene
+struct Ejemplar {
+    int numero;
+    char status;
+    char fecha[11];
+    int prestatario; // Quién lo tiene prestado; 0 si no se sabe (los préstamos que vienen del archivo)
+};
+
+// Representa un libro con su ISBN, nombre y arreglo de ejemplares
+struct Libros {
+    int isbn;
+    char nombre[250];
+    int numEj;
+    struct Ejemplar ejemplares[MAX_EJEMPLAR];
+};
+
+// Lo que hizo una operación: el código y, si se encontró, la posición del libro y del ejemplar
+// (-1 si no aplica). La fecha nueva queda en libros[libro].ejemplares[ejemplar]
+struct ResultadoBib {
+    int codigo;
+    int libro;
+    int ejemplar;
+};
+
+// Recibe los mensajes de la carga del catálogo (aviso 1 para líneas inválidas, 0 para lo leído)
+typedef void (*InformeCarga)(int aviso, const char *mensaje);
+
+// Carga y escritura del catálogo
+int cargarLibros(const char *archivo, struct Libros *libros, int max, InformeCarga informe);
+int escribirLibros(FILE *salida, const struct Libros *libros, int numLibros);
+int guardarLibros(const char *archivo, const struct Libros *libros, int numLibros);
+void imprimirLibros(FILE *salida, const struct Libros *libros, int numLibros);
+
+// Búsqueda y cambios de estado de un libro
+int buscarLibro(const struct Libros *libros, int numLibros, int isbn, const char *nombre);
+int prestarEjemplar(struct Libros *libro, int prestatario);
+int ejemplarDe(const struct Libros *libro, int prestatario);
+void devolverEjemplar(struct Libros *libro, int j);
+void renovarEjemplar(struct Libros *libro, int j);
+struct ResultadoBib aplicarOperacion(struct Libros *libros, int numLibros, char tipo, int isbn, const char *nombre, int prestatario);
+
+// Fechas dd-mm-aaaa
+void extenderFecha(char *fecha);
+int fechaCompacta(const char *fecha);
+
+#endif